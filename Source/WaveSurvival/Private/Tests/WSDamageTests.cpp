@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSDamageSubsystem.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWSDamageKernelTest, "WaveSurvival.Damage.MitigationKernel",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWSDamageKernelTest::RunTest(const FString& Parameters)
+{
+	// Odd count so the scalar tail runs too
+	constexpr int32 Count = 100003;
+
+	TArray<float> Amounts;
+	TArray<float> Armors;
+	TArray<float> CritMultipliers;
+	TArray<float> Damages;
+	Amounts.SetNumUninitialized(Count);
+	Armors.SetNumUninitialized(Count);
+	CritMultipliers.SetNumUninitialized(Count);
+	Damages.SetNumUninitialized(Count);
+
+	// Armor strays outside [0, 1] so the clamp is covered; the first lanes pin the edges exactly
+	FRandomStream Random(19);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Amounts[i] = Random.FRandRange(0.0f, 5000.0f);
+		Armors[i] = Random.FRandRange(-0.5f, 1.5f);
+		CritMultipliers[i] = Random.FRand() < 0.5f ? 1.0f : Random.FRandRange(1.0f, 4.0f);
+	}
+
+	const float EdgeArmors[] = { 0.0f, 1.0f, -1.0f, 2.0f, 0.5f, UE_SMALL_NUMBER, 1.0f - UE_KINDA_SMALL_NUMBER, 0.25f };
+	for (int32 i = 0; i < UE_ARRAY_COUNT(EdgeArmors); ++i)
+	{
+		Armors[i] = EdgeArmors[i];
+		Amounts[i] = i % 2 == 0 ? 0.0f : MAX_flt / 8.0f;
+	}
+
+	UWSDamageSubsystem::MitigateDamageBatch(Amounts.GetData(), Armors.GetData(), CritMultipliers.GetData(), Damages.GetData(), Count);
+
+	int32 Mismatches = 0;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const float Expected = UWSDamageSubsystem::MitigateDamage(Amounts[i], Armors[i], CritMultipliers[i]);
+		if (FMemory::Memcmp(&Expected, &Damages[i], sizeof(float)) != 0 && Mismatches++ < 10)
+		{
+			AddError(FString::Printf(TEXT("Lane %d: kernel %.9g, scalar %.9g"), i, Damages[i], Expected));
+		}
+	}
+
+	TestEqual(TEXT("Results differing from the scalar path"), Mismatches, 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSHitboxSubsystem.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWSHitboxKernelTest, "WaveSurvival.Hitbox.CapsuleKernel",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWSHitboxKernelTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Count = 4096;
+	constexpr int32 NumRays = 64;
+	constexpr float Length = 3000.0f;
+
+	// Capsules around the ray start; every eighth is a sphere, and the last lane of each group of 16 is padding
+	TArray<float> CenterX;
+	TArray<float> CenterY;
+	TArray<float> CenterZ;
+	TArray<float> HalfHeights;
+	TArray<float> RadiiSq;
+	TArray<float> Distances;
+	FRandomStream Random(21);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		CenterX.Add(Random.FRandRange(-500.0f, 3500.0f));
+		CenterY.Add(Random.FRandRange(-300.0f, 300.0f));
+		CenterZ.Add(Random.FRandRange(-300.0f, 300.0f));
+		HalfHeights.Add(i % 8 == 0 ? 0.0f : Random.FRandRange(10.0f, 80.0f));
+		RadiiSq.Add(i % 16 == 15 ? -1.0f : FMath::Square(Random.FRandRange(10.0f, 60.0f)));
+	}
+	Distances.SetNumUninitialized(Count);
+
+	int32 Hits = 0;
+	int32 Failures = 0;
+	for (int32 Ray = 0; Ray < NumRays && Failures < 10; ++Ray)
+	{
+		// Mostly along +X, tilted enough to exercise the capsule ends
+		const FVector3f Direction = FVector3f(1.0f, Random.FRandRange(-0.15f, 0.15f), Random.FRandRange(-0.3f, 0.3f)).GetSafeNormal();
+		const FVector End = FVector(Direction) * Length;
+
+		UWSHitboxSubsystem::RaycastCapsules(Direction, Length, CenterX.GetData(), CenterY.GetData(), CenterZ.GetData(),
+			HalfHeights.GetData(), RadiiSq.GetData(), Distances.GetData(), Count);
+
+		for (int32 i = 0; i < Count && Failures < 10; ++i)
+		{
+			const bool bKernelHit = Distances[i] != FLT_MAX;
+			if (RadiiSq[i] < 0.0f)
+			{
+				if (bKernelHit)
+				{
+					AddError(FString::Printf(TEXT("Ray %d hit padding lane %d"), Ray, i));
+					Failures++;
+				}
+				continue;
+			}
+
+			// Scalar reference: closest approach between the ray and the capsule axis
+			const FVector Center(CenterX[i], CenterY[i], CenterZ[i]);
+			const FVector AxisOffset(0.0f, 0.0f, HalfHeights[i]);
+			FVector PointOnRay;
+			FVector PointOnAxis;
+			FMath::SegmentDistToSegmentSafe(FVector::ZeroVector, End, Center - AxisOffset, Center + AxisOffset, PointOnRay, PointOnAxis);
+
+			const float Radius = FMath::Sqrt(RadiiSq[i]);
+			const float Gap = (float)FVector::Dist(PointOnRay, PointOnAxis) - Radius;
+
+			// Rays grazing the surface may round either way
+			if (FMath::Abs(Gap) < 0.05f)
+			{
+				continue;
+			}
+
+			const bool bExpectedHit = Gap < 0.0f;
+			bool bMatch = bKernelHit == bExpectedHit;
+
+			// Entry lies between the start and the closest approach, and is exact for spheres the ray passes
+			if (bMatch && bKernelHit)
+			{
+				Hits++;
+				const float Closest = (float)PointOnRay.Size();
+				bMatch = Distances[i] >= 0.0f && Distances[i] <= Closest + 0.05f;
+
+				const float Along = (float)FVector::DotProduct(Center, FVector(Direction));
+				if (bMatch && HalfHeights[i] == 0.0f && Along >= 0.0f && Along <= Length)
+				{
+					const float ExpectedEntry = FMath::Max(0.0f, Along - FMath::Sqrt(FMath::Max(0.0f, RadiiSq[i] - (float)(Center - FVector(Direction) * Along).SizeSquared())));
+					bMatch = FMath::IsNearlyEqual(Distances[i], ExpectedEntry, 0.05f);
+				}
+			}
+
+			if (!bMatch)
+			{
+				AddError(FString::Printf(TEXT("Ray %d, capsule %d: kernel %s at %.3f, reference %s (gap %.3f)"), Ray, i,
+					bKernelHit ? TEXT("hit") : TEXT("missed"), Distances[i], bExpectedHit ? TEXT("hit") : TEXT("miss"), Gap));
+				Failures++;
+			}
+		}
+	}
+
+	TestTrue(TEXT("Rays hit some capsules"), Hits > 0);
+	return Failures == 0;
+}
+
+#endif
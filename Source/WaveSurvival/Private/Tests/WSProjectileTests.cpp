@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSProjectileSubsystem.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWSProjectileSweepCapsuleTest, "WaveSurvival.Projectiles.SweepCapsule",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWSProjectileSweepCapsuleTest::RunTest(const FString& Parameters)
+{
+	// Upright capsule at the origin, 40 radius and 90 half height, so its axis runs from z = -50 to z = 50
+	const FVector Center = FVector::ZeroVector;
+	const float CapsuleRadius = 40.0f;
+	const float HalfHeight = 90.0f;
+	float DistSq;
+
+	TestTrue(TEXT("Path through the centre hits"),
+		UWSProjectileSubsystem::SweepCapsule(FVector(-200.0f, 0.0f, 0.0f), FVector(200.0f, 0.0f, 0.0f), 0.0f, Center, CapsuleRadius, HalfHeight, DistSq));
+	TestEqual(TEXT("Closest point of a path through the axis is on the axis"), DistSq, 200.0f * 200.0f);
+
+	TestFalse(TEXT("Path beside the capsule misses"),
+		UWSProjectileSubsystem::SweepCapsule(FVector(-200.0f, 45.0f, 0.0f), FVector(200.0f, 45.0f, 0.0f), 0.0f, Center, CapsuleRadius, HalfHeight, DistSq));
+	TestTrue(TEXT("Projectile radius closes the gap"),
+		UWSProjectileSubsystem::SweepCapsule(FVector(-200.0f, 45.0f, 0.0f), FVector(200.0f, 45.0f, 0.0f), 10.0f, Center, CapsuleRadius, HalfHeight, DistSq));
+
+	// Above the cylinder but within the top hemisphere, and just above it
+	TestTrue(TEXT("Path through the top hemisphere hits"),
+		UWSProjectileSubsystem::SweepCapsule(FVector(-200.0f, 0.0f, 85.0f), FVector(200.0f, 0.0f, 85.0f), 0.0f, Center, CapsuleRadius, HalfHeight, DistSq));
+	TestFalse(TEXT("Path over the top misses"),
+		UWSProjectileSubsystem::SweepCapsule(FVector(-200.0f, 0.0f, 95.0f), FVector(200.0f, 0.0f, 95.0f), 0.0f, Center, CapsuleRadius, HalfHeight, DistSq));
+
+	// A step that ends short of the capsule must not hit, however fast the projectile is
+	TestFalse(TEXT("Step ending short of the capsule misses"),
+		UWSProjectileSubsystem::SweepCapsule(FVector(-500.0f, 0.0f, 0.0f), FVector(-50.0f, 0.0f, 0.0f), 0.0f, Center, CapsuleRadius, HalfHeight, DistSq));
+	TestTrue(TEXT("Step starting inside the capsule hits"),
+		UWSProjectileSubsystem::SweepCapsule(FVector(10.0f, 0.0f, 0.0f), FVector(300.0f, 0.0f, 0.0f), 0.0f, Center, CapsuleRadius, HalfHeight, DistSq));
+
+	return true;
+}
+
+#endif
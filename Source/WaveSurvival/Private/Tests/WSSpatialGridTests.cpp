@@ -0,0 +1,151 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSSpatialGridSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Game world whose spatial grid holds point actors as enemies; destroyed with the fixture
+	struct FWSTestGridWorld
+	{
+		UWorld* World = nullptr;
+		UWSSpatialGridSubsystem* Grid = nullptr;
+		TArray<AActor*> Enemies;
+
+		FWSTestGridWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+			World->InitializeActorsForPlay(FURL());
+			Grid = World->GetSubsystem<UWSSpatialGridSubsystem>();
+		}
+
+		~FWSTestGridWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		// Scatters Count enemies over a square of HalfExtent around the origin
+		void AddEnemies(int32 Count, float HalfExtent, int32 Seed)
+		{
+			FRandomStream Random(Seed);
+			for (int32 i = 0; i < Count; ++i)
+			{
+				const FVector Location(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(0.0f, 200.0f));
+				AActor* Enemy = World->SpawnActor<ATargetPoint>(Location, FRotator::ZeroRotator);
+				Grid->RegisterActor(Enemy, EWSSpatialCategory::Enemy);
+				Enemies.Add(Enemy);
+			}
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWSSpatialGridChainTest, "WaveSurvival.SpatialGrid.QueryChain",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWSSpatialGridChainTest::RunTest(const FString& Parameters)
+{
+	FWSTestGridWorld TestWorld;
+	if (!TestNotNull(TEXT("Spatial grid"), TestWorld.Grid))
+	{
+		return false;
+	}
+
+	constexpr int32 MaxHops = 5;
+	constexpr float JumpRadius = 800.0f;
+	TestWorld.AddEnemies(2000, 10000.0f, 17);
+
+	// Every chain must match a linear scan that hops to the nearest unvisited enemy in range
+	TArray<AActor*> Chain;
+	TArray<AActor*> Expected;
+	for (int32 Start = 0; Start < TestWorld.Enemies.Num(); Start += 10)
+	{
+		TestWorld.Grid->QueryChain(TestWorld.Enemies[Start], EWSSpatialCategory::Enemy, MaxHops, JumpRadius, Chain);
+
+		Expected.Reset();
+		Expected.Add(TestWorld.Enemies[Start]);
+		for (int32 Hop = 0; Hop < MaxHops; ++Hop)
+		{
+			const FVector From = Expected.Last()->GetActorLocation();
+			AActor* Best = nullptr;
+			double BestDistSq = FMath::Square(JumpRadius);
+			for (AActor* Enemy : TestWorld.Enemies)
+			{
+				const double DistSq = FVector::DistSquared(From, Enemy->GetActorLocation());
+				if (DistSq <= BestDistSq && !Expected.Contains(Enemy))
+				{
+					BestDistSq = DistSq;
+					Best = Enemy;
+				}
+			}
+
+			if (!Best)
+			{
+				break;
+			}
+			Expected.Add(Best);
+		}
+
+		if (!TestTrue(FString::Printf(TEXT("Chain from enemy %d matches the linear scan"), Start), Chain == Expected))
+		{
+			break;
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWSSpatialGridSegmentTest, "WaveSurvival.SpatialGrid.QuerySegment",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWSSpatialGridSegmentTest::RunTest(const FString& Parameters)
+{
+	FWSTestGridWorld TestWorld;
+	if (!TestNotNull(TEXT("Spatial grid"), TestWorld.Grid))
+	{
+		return false;
+	}
+
+	TestWorld.AddEnemies(3000, 10000.0f, 21);
+
+	// Segments from under one cell to many cells long, where the chunk squares overlap the most
+	FRandomStream Random(42);
+	TArray<AActor*> Found;
+	for (int32 Query = 0; Query < 200; ++Query)
+	{
+		const FVector Start(Random.FRandRange(-10000.0f, 10000.0f), Random.FRandRange(-10000.0f, 10000.0f), 100.0f);
+		const FVector End = Start + Random.GetUnitVector() * Random.FRandRange(100.0f, 8000.0f);
+		const float Radius = Random.FRandRange(50.0f, 400.0f);
+
+		TestWorld.Grid->QuerySegment(Start, End, Radius, EWSSpatialCategory::Enemy, Found);
+
+		TSet<AActor*> Unique(Found);
+		int32 Expected = 0;
+		bool bMissed = false;
+		for (AActor* Enemy : TestWorld.Enemies)
+		{
+			if (FMath::PointDistToSegmentSquared(Enemy->GetActorLocation(), Start, End) <= FMath::Square(Radius))
+			{
+				Expected++;
+				bMissed |= !Unique.Contains(Enemy);
+			}
+		}
+
+		const bool bMatch = Unique.Num() == Found.Num() && Found.Num() == Expected && !bMissed;
+		if (!TestTrue(FString::Printf(TEXT("Query %d returns each enemy near the segment exactly once (%d found, %d unique, %d expected)"),
+			Query, Found.Num(), Unique.Num(), Expected), bMatch))
+		{
+			break;
+		}
+	}
+
+	return true;
+}
+
+#endif
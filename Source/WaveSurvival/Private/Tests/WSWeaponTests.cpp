@@ -0,0 +1,152 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSWeaponBase.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	int32 SimulateAutomaticFire(TConstArrayView<float> FrameTimes, int32 NumFrames, float FireInterval, int32 MaxShots)
+	{
+		float Accumulator = 0.0f;
+		int32 Shots = 0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Shots += AWSWeaponBase::ConsumeShotsOwed(Accumulator, FrameTimes[Frame % FrameTimes.Num()], FireInterval, MaxShots);
+		}
+		return Shots;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWSWeaponFireRateTest, "WaveSurvival.Weapon.FireRate",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWSWeaponFireRateTest::RunTest(const FString& Parameters)
+{
+	// Frame times and intervals are powers of two so every sum is exact and the expected counts are too
+	const float FireInterval = 1.0f / 16.0f;
+
+	// Fixed rates from 8 to 128 Hz over 10 seconds all owe 160 shots
+	for (const int32 FrameRate : {8, 16, 32, 64, 128})
+	{
+		const float FrameTime = 1.0f / FrameRate;
+		TestEqual(FString::Printf(TEXT("%d Hz"), FrameRate),
+			SimulateAutomaticFire(MakeArrayView(&FrameTime, 1), FrameRate * 10, FireInterval, MAX_int32), 160);
+	}
+
+	// Uneven frames, including a hitch of several intervals, repeated for 10 seconds (64 patterns of 5/32s)
+	const float Uneven[] = { 1.0f / 64.0f, 3.0f / 128.0f, 1.0f / 32.0f, 11.0f / 128.0f };
+	TestEqual(TEXT("Uneven frame times"), SimulateAutomaticFire(Uneven, 4 * 64, FireInterval, MAX_int32), 160);
+
+	// A single long frame pays out every interval it covers
+	float Accumulator = 0.0f;
+	TestEqual(TEXT("Hitch of 0.25s"), AWSWeaponBase::ConsumeShotsOwed(Accumulator, 0.25f, FireInterval, MAX_int32), 4);
+	TestEqual(TEXT("Hitch leaves nothing banked"), Accumulator, 0.0f);
+
+	// The remainder carries into the next frame
+	Accumulator = 0.0f;
+	TestEqual(TEXT("Partial interval fires nothing"), AWSWeaponBase::ConsumeShotsOwed(Accumulator, 3.0f / 64.0f, FireInterval, MAX_int32), 0);
+	TestEqual(TEXT("Carried remainder completes the interval"), AWSWeaponBase::ConsumeShotsOwed(Accumulator, 1.0f / 64.0f, FireInterval, MAX_int32), 1);
+
+	// Shots are capped by the magazine and the backlog beyond one interval is dropped
+	Accumulator = 0.0f;
+	TestEqual(TEXT("Capped by MaxShots"), AWSWeaponBase::ConsumeShotsOwed(Accumulator, 1.0f, FireInterval, 3), 3);
+	TestEqual(TEXT("Backlog clamped to one interval"), Accumulator, FireInterval);
+	TestEqual(TEXT("Empty magazine fires nothing"), AWSWeaponBase::ConsumeShotsOwed(Accumulator, 1.0f, FireInterval, 0), 0);
+
+	// No interval: one shot per frame whatever the frame time
+	Accumulator = 0.0f;
+	TestEqual(TEXT("Zero interval fires once per frame"), SimulateAutomaticFire(Uneven, 40, 0.0f, MAX_int32), 40);
+
+	// Real frame rates against real intervals, including the default FireRate, where float rounding does occur.
+	// Over a minute every rate stays within the one shot the accumulator may be carrying, so DPS doesn't depend on frame rate.
+	for (const float RealInterval : {0.1f, 0.075f, 1.0f / 7.0f})
+	{
+		const double IdealShots = 60.0 / RealInterval;
+		int32 FewestShots = MAX_int32;
+		int32 MostShots = 0;
+		for (const int32 FrameRate : {20, 30, 60, 120})
+		{
+			const float FrameTime = 1.0f / FrameRate;
+			const int32 Shots = SimulateAutomaticFire(MakeArrayView(&FrameTime, 1), FrameRate * 60, RealInterval, MAX_int32);
+			TestTrue(FString::Printf(TEXT("%d Hz at %.3fs interval fires %d of %.2f ideal shots"), FrameRate, RealInterval, Shots, IdealShots),
+				FMath::Abs(Shots - IdealShots) <= 1.0);
+
+			FewestShots = FMath::Min(FewestShots, Shots);
+			MostShots = FMath::Max(MostShots, Shots);
+		}
+		TestTrue(FString::Printf(TEXT("Frame rates agree at %.3fs interval"), RealInterval), MostShots - FewestShots <= 1);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWSWeaponAckTest, "WaveSurvival.Weapon.PredictionAcks",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWSWeaponAckTest::RunTest(const FString& Parameters)
+{
+	// The next sequence is one past the last shot fired, so an ack of the last shot leaves nothing in flight
+	TestEqual(TEXT("Everything acked"), AWSWeaponBase::GetCorrectedAmmo(20, 10, 11), 20);
+	TestEqual(TEXT("Three shots in flight"), AWSWeaponBase::GetCorrectedAmmo(20, 10, 14), 17);
+	TestEqual(TEXT("More in flight than acked ammo"), AWSWeaponBase::GetCorrectedAmmo(2, 10, 16), 0);
+	TestEqual(TEXT("Nothing fired yet"), AWSWeaponBase::GetCorrectedAmmo(30, 0, 1), 30);
+	TestEqual(TEXT("Magazine over 255"), AWSWeaponBase::GetCorrectedAmmo(500, 10, 14), 497);
+
+	// Sequences wrap at 16 bits
+	TestEqual(TEXT("Shots in flight across the wrap"), AWSWeaponBase::GetCorrectedAmmo(20, MAX_uint16 - 1, 3), 16);
+	TestEqual(TEXT("Acked shot is the last before the wrap"), AWSWeaponBase::GetCorrectedAmmo(20, MAX_uint16, 0), 20);
+
+	TestEqual(TEXT("Same reload"), (int32)AWSWeaponBase::GetReloadDelta(4, 4), 0);
+	TestEqual(TEXT("Server reloaded once more"), (int32)AWSWeaponBase::GetReloadDelta(5, 4), 1);
+	TestEqual(TEXT("Ack from before a local reload"), (int32)AWSWeaponBase::GetReloadDelta(4, 5), -1);
+
+	// Reload counts wrap at 8 bits
+	TestEqual(TEXT("Server reloaded across the wrap"), (int32)AWSWeaponBase::GetReloadDelta(1, MAX_uint8), 2);
+	TestEqual(TEXT("Stale ack across the wrap"), (int32)AWSWeaponBase::GetReloadDelta(MAX_uint8, 0), -1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWSWeaponServerFireRateTest, "WaveSurvival.Weapon.ServerFireRate",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWSWeaponServerFireRateTest::RunTest(const FString& Parameters)
+{
+	const float FireInterval = 1.0f / 8.0f;
+	const float Tolerance = 1.0f / 4.0f;
+
+	auto AcceptBatch = [&](double& ShotClock, double Now, int32 ShotCount)
+	{
+		int32 Accepted = 0;
+		for (int32 Shot = 0; Shot < ShotCount; ++Shot)
+		{
+			Accepted += AWSWeaponBase::ConsumeFireRateBudget(ShotClock, Now, FireInterval, Tolerance) ? 1 : 0;
+		}
+		return Accepted;
+	};
+
+	// After a long pause a whole magazine in one batch only gets the banked tolerance plus one
+	double ShotClock = 0.0;
+	TestEqual(TEXT("Magazine dumped after a pause"), AcceptBatch(ShotClock, 10.0, 30), 3);
+	TestEqual(TEXT("Immediate follow-up batch"), AcceptBatch(ShotClock, 10.0, 30), 0);
+
+	// Steady fire at the weapon's rate is always accepted, one shot per interval
+	ShotClock = 0.0;
+	int32 Accepted = 0;
+	for (int32 Batch = 1; Batch <= 80; ++Batch)
+	{
+		Accepted += AcceptBatch(ShotClock, 20.0 + Batch * FireInterval, 1);
+	}
+	TestEqual(TEXT("Steady fire"), Accepted, 80);
+
+	// Two frames of shots delayed and delivered together are still accepted
+	ShotClock = 0.0;
+	AcceptBatch(ShotClock, 30.0, 1);
+	TestEqual(TEXT("Bunched batches"), AcceptBatch(ShotClock, 30.25, 1) + AcceptBatch(ShotClock, 30.25, 1), 2);
+
+	return true;
+}
+
+#endif
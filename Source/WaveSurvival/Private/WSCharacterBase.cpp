@@ -3,10 +3,12 @@
 #include "WSCharacterBase.h"
 #include "WSPlayerState.h"
 #include "WSWeaponBase.h"
+#include "WSSpatialGridSubsystem.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
+#include "Net/UnrealNetwork.h"
 
 AWSCharacterBase::AWSCharacterBase()
 {
@@ -31,6 +33,7 @@ AWSCharacterBase::AWSCharacterBase()
 	bIsFiring = false;
 	bIsReloading = false;
 	bIsDowned = false;
+	ZoneDamageReduction = 0.0f;
 }
 
 void AWSCharacterBase::BeginPlay()
@@ -44,8 +47,8 @@ void AWSCharacterBase::BeginPlay()
 		WSPlayerState->CharacterClass = CharacterClass;
 	}
 
-	// Spawn weapon
-	if (WeaponClass)
+	// Spawn weapon; clients receive it through replication
+	if (WeaponClass && HasAuthority())
 	{
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.Owner = this;
@@ -58,9 +61,26 @@ void AWSCharacterBase::BeginPlay()
 		}
 	}
 
+	UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (SpatialGrid)
+	{
+		SpatialGrid->RegisterActor(this, EWSSpatialCategory::Player);
+	}
+
 	UE_LOG(LogTemp, Log, TEXT("Character spawned: Class %d"), (int32)CharacterClass);
 }
 
+void AWSCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (SpatialGrid)
+	{
+		SpatialGrid->UnregisterActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AWSCharacterBase::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
@@ -69,6 +89,13 @@ void AWSCharacterBase::Tick(float DeltaTime)
 	ApplyHealthRegen(DeltaTime);
 }
 
+void AWSCharacterBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AWSCharacterBase, CurrentWeapon);
+}
+
 void AWSCharacterBase::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
@@ -129,6 +156,11 @@ void AWSCharacterBase::Reload()
 	UE_LOG(LogTemp, Log, TEXT("Reloading weapon"));
 }
 
+void AWSCharacterBase::AddZoneDamageReduction(float Delta)
+{
+	ZoneDamageReduction += Delta;
+}
+
 void AWSCharacterBase::TakeDamageCustom(float DamageAmount, AActor* DamageCauser)
 {
 	if (!WSPlayerState || bIsDowned)
@@ -136,8 +168,9 @@ void AWSCharacterBase::TakeDamageCustom(float DamageAmount, AActor* DamageCauser
 		return;
 	}
 
-	// Apply damage reduction
+	// Apply damage reduction, then any shield zones
 	float FinalDamage = DamageAmount * (1.0f - WSPlayerState->PlayerStats.DamageReduction);
+	FinalDamage *= 1.0f - FMath::Clamp(ZoneDamageReduction, 0.0f, 1.0f);
 	
 	WSPlayerState->PlayerStats.CurrentHealth -= FinalDamage;
 
@@ -0,0 +1,227 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSDamageSubsystem.h"
+#include "WaveSurvival.h"
+#include "WSEnemyBase.h"
+#include "WSEnemyManagerSubsystem.h"
+#include "WSGameState.h"
+#include "WSPlayerState.h"
+#include "Engine/World.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Resolve"), STAT_WSDamageResolve, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Events"), STAT_WSDamageEvents, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damaged Enemies"), STAT_WSDamagedEnemies, STATGROUP_WaveSurvival);
+
+bool UWSDamageSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWSDamageSubsystem::Deinitialize()
+{
+	PendingEvents.Empty();
+	FrameDamage.Empty();
+	FrameDamageIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWSDamageSubsystem::Tick(float DeltaTime)
+{
+	ResolvePendingDamage();
+}
+
+TStatId UWSDamageSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWSDamageSubsystem, STATGROUP_Tickables);
+}
+
+void UWSDamageSubsystem::QueueDamage(const FWSDamageEvent& Event)
+{
+	if (Event.Amount > 0.0f && Event.Target.IsSet())
+	{
+		PendingEvents.Enqueue(Event);
+	}
+}
+
+void UWSDamageSubsystem::ResolvePendingDamage()
+{
+	check(IsInGameThread());
+	SCOPE_CYCLE_COUNTER(STAT_WSDamageResolve);
+
+	FrameEvents.Reset();
+	FWSDamageEvent Event;
+	while (PendingEvents.Dequeue(Event))
+	{
+		FrameEvents.Add(Event);
+	}
+
+	ResolveEvents(FrameEvents, nullptr);
+
+	SET_DWORD_STAT(STAT_WSDamageEvents, FrameEvents.Num());
+	SET_DWORD_STAT(STAT_WSDamagedEnemies, FrameDamage.Num());
+}
+
+void UWSDamageSubsystem::ApplyDamageBatch(TConstArrayView<FWSDamageEvent> Events, TBitArray<>& OutDied)
+{
+	check(IsInGameThread());
+	SCOPE_CYCLE_COUNTER(STAT_WSDamageResolve);
+
+	// A death in the batch being resolved can deal damage of its own; the scratch buffers are in use, so it lands next frame
+	if (bResolving)
+	{
+		OutDied.Init(false, Events.Num());
+		for (const FWSDamageEvent& Event : Events)
+		{
+			QueueDamage(Event);
+		}
+		return;
+	}
+
+	ResolveEvents(Events, &OutDied);
+}
+
+float UWSDamageSubsystem::MitigateDamage(float Amount, float Armor, float CritMultiplier)
+{
+	return Amount * (1.0f - FMath::Clamp(Armor, 0.0f, 1.0f)) * CritMultiplier;
+}
+
+void UWSDamageSubsystem::MitigateDamageBatch(const float* Amounts, const float* Armors, const float* CritMultipliers, float* OutDamages, int32 Count)
+{
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float One = VectorOneFloat();
+
+	// Same operations in the same order as MitigateDamage, so every lane rounds identically
+	int32 i = 0;
+	for (; i + 4 <= Count; i += 4)
+	{
+		const VectorRegister4Float Armor = VectorMin(VectorMax(VectorLoad(Armors + i), Zero), One);
+		const VectorRegister4Float Damage = VectorMultiply(VectorMultiply(VectorLoad(Amounts + i), VectorSubtract(One, Armor)), VectorLoad(CritMultipliers + i));
+		VectorStore(Damage, OutDamages + i);
+	}
+
+	for (; i < Count; ++i)
+	{
+		OutDamages[i] = MitigateDamage(Amounts[i], Armors[i], CritMultipliers[i]);
+	}
+}
+
+void UWSDamageSubsystem::ResolveEvents(TConstArrayView<FWSDamageEvent> Events, TBitArray<>* OutDied)
+{
+	if (OutDied)
+	{
+		OutDied->Init(false, Events.Num());
+	}
+
+	UWSEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UWSEnemyManagerSubsystem>();
+	if (!EnemyManager || !ensureMsgf(!bResolving, TEXT("Damage batches can't be applied while another batch is resolving")))
+	{
+		return;
+	}
+
+	TGuardValue<bool> ResolvingGuard(bResolving, true);
+
+	const int32 NumEvents = Events.Num();
+	EventEnemies.SetNumUninitialized(NumEvents, EAllowShrinking::No);
+	PackedAmounts.SetNumUninitialized(NumEvents, EAllowShrinking::No);
+	PackedArmors.SetNumUninitialized(NumEvents, EAllowShrinking::No);
+	PackedCritMultipliers.SetNumUninitialized(NumEvents, EAllowShrinking::No);
+	MitigatedDamages.SetNumUninitialized(NumEvents, EAllowShrinking::No);
+	EventEntries.SetNumUninitialized(NumEvents, EAllowShrinking::No);
+
+	// Pack the mitigation inputs. Handles to enemies that died or were pooled since the hit no longer resolve.
+	for (int32 i = 0; i < NumEvents; ++i)
+	{
+		AWSEnemyBase* Enemy = EnemyManager->GetEnemy(Events[i].Target);
+		if (Enemy && Enemy->IsPooled())
+		{
+			Enemy = nullptr;
+		}
+
+		EventEnemies[i] = Enemy;
+		PackedAmounts[i] = Enemy ? Events[i].Amount : 0.0f;
+		PackedArmors[i] = Enemy ? Enemy->GetEffectiveArmor() : 0.0f;
+		PackedCritMultipliers[i] = Enemy ? Enemy->GetCritMultiplier(Events[i].bIsCritical) : 1.0f;
+	}
+
+	MitigateDamageBatch(PackedAmounts.GetData(), PackedArmors.GetData(), PackedCritMultipliers.GetData(), MitigatedDamages.GetData(), NumEvents);
+
+	FrameDamage.Reset();
+	FrameDamageIndices.Reset();
+
+	// Group events per enemy
+	for (int32 i = 0; i < NumEvents; ++i)
+	{
+		AWSEnemyBase* Enemy = EventEnemies[i];
+		if (!Enemy)
+		{
+			EventEntries[i] = INDEX_NONE;
+			continue;
+		}
+
+		const FWSDamageEvent& Event = Events[i];
+		int32& EntryIndex = FrameDamageIndices.FindOrAdd(Event.Target, INDEX_NONE);
+		if (EntryIndex == INDEX_NONE)
+		{
+			EntryIndex = FrameDamage.AddDefaulted();
+			FrameDamage[EntryIndex].Enemy = Enemy;
+		}
+		EventEntries[i] = EntryIndex;
+
+		FEnemyDamage& Entry = FrameDamage[EntryIndex];
+		const float FinalDamage = MitigatedDamages[i];
+		const float Health = Enemy->EnemyStats.CurrentHealth;
+
+		// The hit that crosses zero gets the kill, as it would have when applied one at a time
+		if (Entry.TotalDamage < Health && Entry.TotalDamage + FinalDamage >= Health)
+		{
+			Entry.KillingSlot = Event.InstigatorSlot;
+		}
+
+		Entry.TotalDamage += FinalDamage;
+		Entry.Damage.AddDamage(Event.InstigatorSlot, FinalDamage);
+
+		if (Event.Element != EWSElementalType::None)
+		{
+			Entry.ElementMask |= 1 << (uint8)Event.Element;
+			Entry.ElementSlots[(uint8)Event.Element] = Event.InstigatorSlot;
+		}
+	}
+
+	AWSGameState* GameState = GetWorld()->GetGameState<AWSGameState>();
+
+	for (FEnemyDamage& Entry : FrameDamage)
+	{
+		Entry.bKilled = Entry.Enemy->ApplyResolvedDamage(Entry.Damage, Entry.TotalDamage);
+		if (!Entry.bKilled)
+		{
+			// Each element is applied once per enemy per frame, however many hits carried it
+			for (uint8 Element = 1; Element <= (uint8)EWSElementalType::Poison; ++Element)
+			{
+				if (Entry.ElementMask & (1 << Element))
+				{
+					Entry.Enemy->ApplyElementalEffect((EWSElementalType)Element, Entry.ElementSlots[Element]);
+				}
+			}
+			continue;
+		}
+
+		AWSPlayerState* PS = GameState ? GameState->GetPlayerStateForSlot(Entry.KillingSlot) : nullptr;
+		if (PS)
+		{
+			PS->OnKill();
+		}
+	}
+
+	if (OutDied)
+	{
+		for (int32 i = 0; i < NumEvents; ++i)
+		{
+			if (EventEntries[i] != INDEX_NONE && FrameDamage[EventEntries[i]].bKilled)
+			{
+				(*OutDied)[i] = true;
+			}
+		}
+	}
+}
@@ -2,16 +2,38 @@
 
 #include "WSEnemyBase.h"
 #include "WSGameState.h"
+#include "WSGameMode.h"
 #include "WSPlayerState.h"
-#include "Kismet/GameplayStatics.h"
-#include "GameFramework/PlayerController.h"
+#include "WSSpatialGridSubsystem.h"
+#include "WSEnemyManagerSubsystem.h"
+#include "WSStatusEffectSubsystem.h"
+#include "WSExplosionSubsystem.h"
+#include "WSDamageSubsystem.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/CapsuleComponent.h"
 
 AWSEnemyBase::AWSEnemyBase()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Enemies are updated in batches by UWSEnemyManagerSubsystem
+	PrimaryActorTick.bCanEverTick = false;
+
+	// Enemies have no AI controller; the enemy manager feeds movement input directly
+	GetCharacterMovement()->bRunPhysicsWithNoController = true;
+
+	// Enemy capsules ignore each other; crowding is resolved by the enemy manager's separation pass
+	GetCapsuleComponent()->SetCollisionProfileName(TEXT("WSEnemy"));
+
+	// Default humanoid hitboxes inside the standard capsule; enemy classes override these
+	Hitboxes.Add(FWSHitbox(EWSHitRegion::Body, FVector(0.0f, 0.0f, -20.0f), 34.0f, 40.0f));
+	Hitboxes.Add(FWSHitbox(EWSHitRegion::Head, FVector(0.0f, 0.0f, 70.0f), 18.0f, 0.0f));
 
 	bIsBoss = false;
+	bIsPooled = false;
 	CurrentTarget = nullptr;
+	SlowFraction = 0.0f;
+	ArmorShred = 0.0f;
+	ZoneSlowFraction = 0.0f;
+	ZoneArmorShred = 0.0f;
 }
 
 void AWSEnemyBase::BeginPlay()
@@ -20,31 +42,27 @@ void AWSEnemyBase::BeginPlay()
 
 	// Initialize health
 	EnemyStats.CurrentHealth = EnemyStats.MaxHealth;
+	GetCharacterMovement()->MaxWalkSpeed = EnemyStats.MovementSpeed;
+
+	RegisterWithWorldSystems();
 	
 	UE_LOG(LogTemp, Log, TEXT("Enemy spawned: %d with %f health"), 
 		(int32)EnemyType, EnemyStats.MaxHealth);
 }
 
-void AWSEnemyBase::Tick(float DeltaTime)
+void AWSEnemyBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
-
-	// Update target
-	if (bIsBoss)
-	{
-		// Bosses target highest damage dealer
-		CurrentTarget = FindHighestDamageDealer();
-	}
-	else
-	{
-		// Regular enemies target nearest player
-		CurrentTarget = FindNearestPlayer();
-	}
+	UnregisterFromWorldSystems();
 
-	// Move towards target (AI would handle this in a real implementation)
+	Super::EndPlay(EndPlayReason);
 }
 
 bool AWSEnemyBase::TakeDamageCustom(float DamageAmount, AActor* DamageCauser, bool bIsCritical)
+{
+	return TakeDamageFromSlot(DamageAmount, AWSPlayerState::GetPlayerSlotForActor(DamageCauser), bIsCritical);
+}
+
+bool AWSEnemyBase::TakeDamageFromSlot(float DamageAmount, int32 InstigatorSlot, bool bIsCritical)
 {
 	if (EnemyStats.CurrentHealth <= 0)
 	{
@@ -57,30 +75,12 @@ bool AWSEnemyBase::TakeDamageCustom(float DamageAmount, AActor* DamageCauser, bo
 		bIsCritical = false;
 	}
 
-	// Apply armor reduction with clamped armor value
-	float ClampedArmor = FMath::Clamp(EnemyStats.Armor, 0.0f, 1.0f);
-	float FinalDamage = DamageAmount * (1.0f - ClampedArmor);
-
-	// Apply critical multiplier
-	if (bIsCritical)
-	{
-		FinalDamage *= CriticalDamageMultiplier;
-	}
+	const float FinalDamage = GetMitigatedDamage(DamageAmount, bIsCritical);
 
 	EnemyStats.CurrentHealth -= FinalDamage;
 
 	// Track damage from players
-	if (DamageCauser)
-	{
-		if (DamageReceivedFromPlayers.Contains(DamageCauser))
-		{
-			DamageReceivedFromPlayers[DamageCauser] += FinalDamage;
-		}
-		else
-		{
-			DamageReceivedFromPlayers.Add(DamageCauser, FinalDamage);
-		}
-	}
+	DamageLedger.AddDamage(InstigatorSlot, FinalDamage);
 
 	UpdateHealthBar();
 
@@ -97,8 +97,96 @@ bool AWSEnemyBase::TakeDamageCustom(float DamageAmount, AActor* DamageCauser, bo
 	return bKilledEnemy;
 }
 
+float AWSEnemyBase::GetMitigatedDamage(float DamageAmount, bool bIsCritical) const
+{
+	// Shared with the damage subsystem's batch kernel so both paths produce identical results
+	return UWSDamageSubsystem::MitigateDamage(DamageAmount, GetEffectiveArmor(), GetCritMultiplier(bIsCritical));
+}
+
+float AWSEnemyBase::GetEffectiveArmor() const
+{
+	return EnemyStats.Armor - ArmorShred - ZoneArmorShred;
+}
+
+float AWSEnemyBase::GetCritMultiplier(bool bIsCritical) const
+{
+	return (bIsCritical && EnemyStats.bCanCrit) ? CriticalDamageMultiplier : 1.0f;
+}
+
+bool AWSEnemyBase::ApplyResolvedDamage(const FWSDamageLedger& FrameDamage, float TotalDamage)
+{
+	if (EnemyStats.CurrentHealth <= 0 || TotalDamage <= 0.0f)
+	{
+		return false;
+	}
+
+	EnemyStats.CurrentHealth -= TotalDamage;
+
+	for (int32 Slot = 0; Slot < WSMaxPlayers; ++Slot)
+	{
+		DamageLedger.AddDamage(Slot, FrameDamage.GetDamage(Slot));
+	}
+
+	UpdateHealthBar();
+
+	UE_LOG(LogTemp, Verbose, TEXT("Enemy took %f damage this frame, Health: %f"), TotalDamage, EnemyStats.CurrentHealth);
+
+	if (EnemyStats.CurrentHealth <= 0)
+	{
+		Die();
+		return true;
+	}
+
+	return false;
+}
+
+void AWSEnemyBase::ApplyElementalEffect(EWSElementalType Element, int32 InstigatorSlot)
+{
+	// Burn, slow, armor shred and poison are ticked in bulk by the status effect subsystem
+	UWSStatusEffectSubsystem* StatusEffects = GetWorld()->GetSubsystem<UWSStatusEffectSubsystem>();
+	// Electric chains are resolved by the weapon when it hits
+	if (StatusEffects)
+	{
+		StatusEffects->ApplyEffect(EnemyHandle, Element, InstigatorSlot);
+	}
+}
+
+void AWSEnemyBase::SetSlowFraction(float InSlowFraction)
+{
+	SlowFraction = FMath::Clamp(InSlowFraction, 0.0f, 0.9f);
+	UpdateWalkSpeed();
+}
+
+void AWSEnemyBase::SetArmorShred(float InArmorShred)
+{
+	ArmorShred = FMath::Max(InArmorShred, 0.0f);
+}
+
+void AWSEnemyBase::AddZoneModifiers(float SlowDelta, float ArmorShredDelta)
+{
+	ZoneSlowFraction += SlowDelta;
+	ZoneArmorShred += ArmorShredDelta;
+
+	if (SlowDelta != 0.0f)
+	{
+		UpdateWalkSpeed();
+	}
+}
+
+void AWSEnemyBase::UpdateWalkSpeed()
+{
+	// Status and zone slows add up, capped so enemies never stop entirely
+	const float TotalSlow = FMath::Clamp(SlowFraction + ZoneSlowFraction, 0.0f, 0.9f);
+	GetCharacterMovement()->MaxWalkSpeed = EnemyStats.MovementSpeed * (1.0f - TotalSlow);
+}
+
 void AWSEnemyBase::Die()
 {
+	if (bIsPooled)
+	{
+		return;
+	}
+
 	OnDeath();
 	
 	// Notify game state
@@ -113,8 +201,16 @@ void AWSEnemyBase::Die()
 
 	UE_LOG(LogTemp, Log, TEXT("Enemy died: %d"), (int32)EnemyType);
 
-	// Destroy actor
-	Destroy();
+	// Return to the enemy pool on the server, otherwise destroy
+	AWSGameMode* WSGameMode = GetWorld()->GetAuthGameMode<AWSGameMode>();
+	if (WSGameMode)
+	{
+		WSGameMode->ReleaseEnemy(this);
+	}
+	else
+	{
+		Destroy();
+	}
 }
 
 void AWSEnemyBase::AttackTarget()
@@ -132,39 +228,26 @@ void AWSEnemyBase::AttackTarget()
 
 AActor* AWSEnemyBase::FindNearestPlayer()
 {
-	AActor* NearestPlayer = nullptr;
-	float NearestDistance = FLT_MAX;
-
-	TArray<AActor*> Players;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ACharacter::StaticClass(), Players);
-
-	for (AActor* Player : Players)
+	UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (!SpatialGrid)
 	{
-		if (Player && Player != this)
-		{
-			float Distance = FVector::Dist(GetActorLocation(), Player->GetActorLocation());
-			if (Distance < NearestDistance)
-			{
-				NearestDistance = Distance;
-				NearestPlayer = Player;
-			}
-		}
+		return nullptr;
 	}
 
-	return NearestPlayer;
+	return SpatialGrid->FindNearest(GetActorLocation(), EWSSpatialCategory::Player);
 }
 
 AActor* AWSEnemyBase::FindHighestDamageDealer()
 {
 	AActor* HighestDealer = nullptr;
-	float HighestDamage = 0.0f;
 
-	for (const TPair<AActor*, float>& Entry : DamageReceivedFromPlayers)
+	AWSGameState* GameState = GetWorld()->GetGameState<AWSGameState>();
+	if (GameState)
 	{
-		if (Entry.Value > HighestDamage)
+		AWSPlayerState* PS = GameState->GetPlayerStateForSlot(DamageLedger.GetTopSlot());
+		if (PS)
 		{
-			HighestDamage = Entry.Value;
-			HighestDealer = Entry.Key;
+			HighestDealer = PS->GetPawn();
 		}
 	}
 
@@ -183,13 +266,16 @@ void AWSEnemyBase::OnDeath()
 	switch (EnemyType)
 	{
 		case EWSEnemyType::Xurkex: // Tank (Death) - Explodes
-			// TODO: Create explosion effect and damage nearby players
-			UE_LOG(LogTemp, Log, TEXT("Xurkex exploding on death!"));
-			break;
-			
 		case EWSEnemyType::QueenLarvae: // Queen Larvae - Explodes on impact
-			UE_LOG(LogTemp, Log, TEXT("Queen Larvae exploding!"));
+		{
+			// Queued rather than applied here so chain reactions never recurse through Die()
+			UWSExplosionSubsystem* Explosions = GetWorld()->GetSubsystem<UWSExplosionSubsystem>();
+			if (Explosions)
+			{
+				Explosions->QueueExplosion(GetActorLocation(), DeathExplosionRadius, DeathExplosionDamage, DamageLedger.GetTopSlot(), true);
+			}
 			break;
+		}
 			
 		default:
 			break;
@@ -198,24 +284,122 @@ void AWSEnemyBase::OnDeath()
 
 void AWSEnemyBase::DropCurrency()
 {
+	AWSGameState* GameState = GetWorld()->GetGameState<AWSGameState>();
+	if (!GameState)
+	{
+		return;
+	}
+
 	// Award currency to players who damaged this enemy
-	for (const TPair<AActor*, float>& Entry : DamageReceivedFromPlayers)
+	GameState->AwardKillCurrency(DamageLedger, EnemyStats.MaxHealth, EnemyStats.CurrencyDropAmount);
+}
+
+bool AWSEnemyBase::IsPooled() const
+{
+	return bIsPooled;
+}
+
+void AWSEnemyBase::ActivateFromPool(const FVector& Location, const FRotator& Rotation)
+{
+	ResetEnemyState();
+
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	UCharacterMovementComponent* MovementComponent = GetCharacterMovement();
+	if (MovementComponent)
 	{
-		ACharacter* PlayerCharacter = Cast<ACharacter>(Entry.Key);
-		if (PlayerCharacter)
-		{
-			APlayerController* PC = Cast<APlayerController>(PlayerCharacter->GetController());
-			if (PC)
-			{
-				AWSPlayerState* PS = Cast<AWSPlayerState>(PC->PlayerState);
-				if (PS)
-				{
-					// Distribute currency based on damage contribution
-					float DamagePercent = Entry.Value / EnemyStats.MaxHealth;
-					int32 CurrencyAmount = FMath::CeilToInt(EnemyStats.CurrencyDropAmount * DamagePercent);
-					PS->AddCurrency(CurrencyAmount);
-				}
-			}
-		}
+		MovementComponent->SetComponentTickEnabled(true);
+		MovementComponent->SetMovementMode(MOVE_Walking);
+	}
+
+	bIsPooled = false;
+
+	RegisterWithWorldSystems();
+}
+
+void AWSEnemyBase::DeactivateToPool()
+{
+	bIsPooled = true;
+
+	UnregisterFromWorldSystems();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+
+	UCharacterMovementComponent* MovementComponent = GetCharacterMovement();
+	if (MovementComponent)
+	{
+		MovementComponent->StopMovementImmediately();
+		MovementComponent->DisableMovement();
+		MovementComponent->SetComponentTickEnabled(false);
+	}
+
+	CurrentTarget = nullptr;
+	DamageLedger.Reset();
+}
+
+void AWSEnemyBase::ResetEnemyState()
+{
+	// Restore stats from the class defaults so upgrades/debuffs from a previous life don't carry over
+	const AWSEnemyBase* DefaultEnemy = GetClass()->GetDefaultObject<AWSEnemyBase>();
+	EnemyStats = DefaultEnemy->EnemyStats;
+	EnemyStats.CurrentHealth = EnemyStats.MaxHealth;
+	GetCharacterMovement()->MaxWalkSpeed = EnemyStats.MovementSpeed;
+
+	CurrentTarget = nullptr;
+	DamageLedger.Reset();
+	SlowFraction = 0.0f;
+	ArmorShred = 0.0f;
+	ZoneSlowFraction = 0.0f;
+	ZoneArmorShred = 0.0f;
+}
+
+FWSEnemyHandle AWSEnemyBase::GetEnemyHandle() const
+{
+	return EnemyHandle;
+}
+
+void AWSEnemyBase::ApplyPromotedState(float Health, const FWSDamageLedger& InDamageLedger)
+{
+	EnemyStats.CurrentHealth = FMath::Min(Health, EnemyStats.MaxHealth);
+	DamageLedger = InDamageLedger;
+	UpdateHealthBar();
+}
+
+void AWSEnemyBase::SetCurrentTarget(AActor* NewTarget)
+{
+	CurrentTarget = NewTarget;
+}
+
+void AWSEnemyBase::RegisterWithWorldSystems()
+{
+	UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (SpatialGrid)
+	{
+		SpatialGrid->RegisterActor(this, EWSSpatialCategory::Enemy);
+	}
+
+	UWSEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UWSEnemyManagerSubsystem>();
+	if (EnemyManager && !EnemyHandle.IsSet())
+	{
+		EnemyHandle = EnemyManager->RegisterEnemy(this);
+	}
+}
+
+void AWSEnemyBase::UnregisterFromWorldSystems()
+{
+	UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (SpatialGrid)
+	{
+		SpatialGrid->UnregisterActor(this);
+	}
+
+	UWSEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UWSEnemyManagerSubsystem>();
+	if (EnemyManager && EnemyHandle.IsSet())
+	{
+		EnemyManager->UnregisterEnemy(EnemyHandle);
 	}
+	EnemyHandle = FWSEnemyHandle();
 }
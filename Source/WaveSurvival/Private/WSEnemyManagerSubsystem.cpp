@@ -0,0 +1,562 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSEnemyManagerSubsystem.h"
+#include "WaveSurvival.h"
+#include "WSEnemyBase.h"
+#include "WSSpatialGridSubsystem.h"
+#include "WSFlowFieldSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Batch Update"), STAT_WSEnemyBatchUpdate, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Managed Enemies"), STAT_WSManagedEnemies, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies LOD Near"), STAT_WSEnemyLODNear, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies LOD Mid"), STAT_WSEnemyLODMid, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies LOD Far"), STAT_WSEnemyLODFar, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies LOD Dormant"), STAT_WSEnemyLODDormant, STATGROUP_WaveSurvival);
+DECLARE_CYCLE_STAT(TEXT("Enemy Separation"), STAT_WSEnemySeparation, STATGROUP_WaveSurvival);
+
+namespace
+{
+	// Far-away value used to pad the packed arrays to a multiple of four lanes; contributes zero push
+	constexpr float SeparationPadding = 1.0e9f;
+
+	/**
+	 * Sums the push away from every neighbour within Radius, four neighbours per iteration.
+	 * Each neighbour contributes (Offset / Distance) * (1 - Distance / Radius), which is
+	 * Offset * (1 / Distance - 1 / Radius) clamped at zero. Coincident points (the enemy itself) are skipped.
+	 */
+	FVector2f ComputeSeparation(float X, float Y, const float* NeighbourXs, const float* NeighbourYs, int32 Count, float Radius)
+	{
+		const VectorRegister4Float SelfX = VectorSetFloat1(X);
+		const VectorRegister4Float SelfY = VectorSetFloat1(Y);
+		const VectorRegister4Float InvRadius = VectorSetFloat1(1.0f / Radius);
+		const VectorRegister4Float MinDistSq = VectorSetFloat1(1.0f);
+		const VectorRegister4Float Zero = VectorZeroFloat();
+
+		VectorRegister4Float SumX = Zero;
+		VectorRegister4Float SumY = Zero;
+
+		for (int32 i = 0; i < Count; i += 4)
+		{
+			const VectorRegister4Float DX = VectorSubtract(SelfX, VectorLoad(NeighbourXs + i));
+			const VectorRegister4Float DY = VectorSubtract(SelfY, VectorLoad(NeighbourYs + i));
+			const VectorRegister4Float DistSq = VectorMultiplyAdd(DX, DX, VectorMultiply(DY, DY));
+
+			VectorRegister4Float Weight = VectorMax(VectorSubtract(VectorReciprocalSqrt(DistSq), InvRadius), Zero);
+			Weight = VectorSelect(VectorCompareGT(DistSq, MinDistSq), Weight, Zero);
+
+			SumX = VectorMultiplyAdd(DX, Weight, SumX);
+			SumY = VectorMultiplyAdd(DY, Weight, SumY);
+		}
+
+		float LanesX[4];
+		float LanesY[4];
+		VectorStore(SumX, LanesX);
+		VectorStore(SumY, LanesY);
+
+		return FVector2f(LanesX[0] + LanesX[1] + LanesX[2] + LanesX[3], LanesY[0] + LanesY[1] + LanesY[2] + LanesY[3]);
+	}
+}
+
+UWSEnemyManagerSubsystem::UWSEnemyManagerSubsystem()
+{
+	// Near enemies run every frame; farther buckets update, retarget and move less often
+	LODSettings.Add(FWSEnemyLODSettings(2500.0f, 0.0f, 0.2f, 0.0f));
+	LODSettings.Add(FWSEnemyLODSettings(6000.0f, 0.1f, 0.5f, 0.05f));
+	LODSettings.Add(FWSEnemyLODSettings(15000.0f, 0.25f, 1.0f, 0.1f));
+	LODSettings.Add(FWSEnemyLODSettings(0.0f, 0.5f, 2.0f, 0.25f));
+
+	LODEvaluationInterval = 0.5f;
+	LODHysteresis = 500.0f;
+	OnScreenHalfAngle = 50.0f;
+
+	SeparationRadius = 120.0f;
+	SeparationWeight = 1.5f;
+
+	FMemory::Memzero(LODPopulation);
+
+	for (int32 TypeIndex = 0; TypeIndex < NumEnemyTypes; ++TypeIndex)
+	{
+		Batches[TypeIndex].EnemyType = (EWSEnemyType)TypeIndex;
+	}
+}
+
+bool UWSEnemyManagerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWSEnemyManagerSubsystem::Deinitialize()
+{
+	for (int32 TypeIndex = 0; TypeIndex < NumEnemyTypes; ++TypeIndex)
+	{
+		Batches[TypeIndex] = FWSEnemyBatch();
+		Batches[TypeIndex].EnemyType = (EWSEnemyType)TypeIndex;
+		BatchHooks[TypeIndex] = nullptr;
+	}
+
+	Slots.Empty();
+	FreeSlots.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWSEnemyManagerSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSEnemyBatchUpdate);
+	SET_DWORD_STAT(STAT_WSManagedEnemies, GetTotalEnemyCount());
+
+	GatherViewers();
+	FMemory::Memzero(LODPopulation);
+
+	for (int32 TypeIndex = 0; TypeIndex < NumEnemyTypes; ++TypeIndex)
+	{
+		FWSEnemyBatch& Batch = Batches[TypeIndex];
+		if (Batch.Num() == 0)
+		{
+			continue;
+		}
+
+		// Snapshot positions once so the update loop reads contiguous memory
+		for (int32 i = 0; i < Batch.Num(); ++i)
+		{
+			Batch.Positions[i] = Batch.Enemies[i]->GetActorLocation();
+		}
+
+		UpdateSignificance(Batch, DeltaTime);
+
+		if (BatchHooks[TypeIndex])
+		{
+			BatchHooks[TypeIndex](Batch, DeltaTime);
+		}
+		else
+		{
+			UpdateTargeting(Batch, DeltaTime);
+			UpdateSeparation(Batch, DeltaTime);
+			UpdateMovement(Batch, DeltaTime);
+			UpdateAttacks(Batch, DeltaTime);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_WSEnemyLODNear, LODPopulation[(int32)EWSEnemyLOD::Near]);
+	SET_DWORD_STAT(STAT_WSEnemyLODMid, LODPopulation[(int32)EWSEnemyLOD::Mid]);
+	SET_DWORD_STAT(STAT_WSEnemyLODFar, LODPopulation[(int32)EWSEnemyLOD::Far]);
+	SET_DWORD_STAT(STAT_WSEnemyLODDormant, LODPopulation[(int32)EWSEnemyLOD::Dormant]);
+}
+
+TStatId UWSEnemyManagerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWSEnemyManagerSubsystem, STATGROUP_Tickables);
+}
+
+FWSEnemyHandle UWSEnemyManagerSubsystem::RegisterEnemy(AWSEnemyBase* Enemy)
+{
+	if (!Enemy)
+	{
+		return FWSEnemyHandle();
+	}
+
+	int32 SlotIndex;
+	if (FreeSlots.Num() > 0)
+	{
+		SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		SlotIndex = Slots.AddDefaulted();
+	}
+
+	FWSEnemyBatch& Batch = GetBatch(Enemy->EnemyType);
+
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.EnemyType = Enemy->EnemyType;
+	Slot.DenseIndex = Batch.Num();
+
+	Batch.Enemies.Add(Enemy);
+	Batch.SlotIndices.Add(SlotIndex);
+	Batch.Positions.Add(Enemy->GetActorLocation());
+	Batch.Targets.Add(nullptr);
+	// Stagger the first retarget so enemies spawned together don't all retarget on the same frame
+	Batch.RetargetTimers.Add(FMath::FRandRange(0.0f, GetLODSettings(EWSEnemyLOD::Near).RetargetInterval));
+	Batch.AttackTimers.Add(0.0f);
+	Batch.AttackRanges.Add(Enemy->AttackRange);
+	Batch.AttackCooldowns.Add(Enemy->AttackCooldown);
+	Batch.LODs.Add(EWSEnemyLOD::Near);
+	Batch.LODTimers.Add(FMath::FRandRange(0.0f, LODEvaluationInterval));
+	Batch.UpdateAccumulators.Add(0.0f);
+	Batch.StepDeltaTimes.Add(0.0f);
+	Batch.Separations.Add(FVector::ZeroVector);
+
+	// Pooled enemies may still carry the tick rates of a far bucket from their previous life
+	ApplyMovementFidelity(Enemy, EWSEnemyLOD::Near);
+
+	return FWSEnemyHandle(SlotIndex, Slot.Generation);
+}
+
+void UWSEnemyManagerSubsystem::UnregisterEnemy(const FWSEnemyHandle& Handle)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return;
+	}
+
+	FSlot& Slot = Slots[Handle.Index];
+	FWSEnemyBatch& Batch = GetBatch(Slot.EnemyType);
+	const int32 DenseIndex = Slot.DenseIndex;
+
+	// Swap-remove from every array and patch the slot of the element moved into the hole
+	const int32 LastIndex = Batch.Num() - 1;
+	if (DenseIndex != LastIndex)
+	{
+		Slots[Batch.SlotIndices[LastIndex]].DenseIndex = DenseIndex;
+	}
+
+	Batch.Enemies.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	Batch.SlotIndices.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	Batch.Positions.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	Batch.Targets.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	Batch.RetargetTimers.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	Batch.AttackTimers.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	Batch.AttackRanges.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	Batch.AttackCooldowns.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	Batch.LODs.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	Batch.LODTimers.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	Batch.UpdateAccumulators.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	Batch.StepDeltaTimes.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	Batch.Separations.RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+
+	// Bump the generation so stale handles to this slot stop resolving
+	Slot.Generation++;
+	Slot.DenseIndex = INDEX_NONE;
+	FreeSlots.Add(Handle.Index);
+}
+
+bool UWSEnemyManagerSubsystem::IsValidHandle(const FWSEnemyHandle& Handle) const
+{
+	return FindSlot(Handle) != nullptr;
+}
+
+AWSEnemyBase* UWSEnemyManagerSubsystem::GetEnemy(const FWSEnemyHandle& Handle) const
+{
+	const FSlot* Slot = FindSlot(Handle);
+	return Slot ? GetBatch(Slot->EnemyType).Enemies[Slot->DenseIndex] : nullptr;
+}
+
+AActor* UWSEnemyManagerSubsystem::GetTarget(const FWSEnemyHandle& Handle) const
+{
+	const FSlot* Slot = FindSlot(Handle);
+	return Slot ? GetBatch(Slot->EnemyType).Targets[Slot->DenseIndex].Get() : nullptr;
+}
+
+int32 UWSEnemyManagerSubsystem::GetEnemyCount(EWSEnemyType EnemyType) const
+{
+	return GetBatch(EnemyType).Num();
+}
+
+int32 UWSEnemyManagerSubsystem::GetTotalEnemyCount() const
+{
+	int32 Total = 0;
+	for (const FWSEnemyBatch& Batch : Batches)
+	{
+		Total += Batch.Num();
+	}
+	return Total;
+}
+
+int32 UWSEnemyManagerSubsystem::GetLODPopulation(EWSEnemyLOD LOD) const
+{
+	return LODPopulation[(int32)LOD];
+}
+
+const FWSEnemyLODSettings& UWSEnemyManagerSubsystem::GetLODSettings(EWSEnemyLOD LOD) const
+{
+	return LODSettings[FMath::Min((int32)LOD, LODSettings.Num() - 1)];
+}
+
+void UWSEnemyManagerSubsystem::SetBatchUpdateHook(EWSEnemyType EnemyType, FWSEnemyBatchUpdateFunction Hook)
+{
+	BatchHooks[(int32)EnemyType] = MoveTemp(Hook);
+}
+
+void UWSEnemyManagerSubsystem::ClearBatchUpdateHook(EWSEnemyType EnemyType)
+{
+	BatchHooks[(int32)EnemyType] = nullptr;
+}
+
+void UWSEnemyManagerSubsystem::UpdateTargeting(FWSEnemyBatch& Batch, float DeltaTime)
+{
+	UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+
+	for (int32 i = 0; i < Batch.Num(); ++i)
+	{
+		if (Batch.StepDeltaTimes[i] <= 0.0f)
+		{
+			continue;
+		}
+
+		Batch.RetargetTimers[i] -= Batch.StepDeltaTimes[i];
+		if (Batch.RetargetTimers[i] > 0.0f)
+		{
+			continue;
+		}
+		Batch.RetargetTimers[i] = GetLODSettings(Batch.LODs[i]).RetargetInterval;
+
+		AWSEnemyBase* Enemy = Batch.Enemies[i];
+		AActor* NewTarget = nullptr;
+
+		if (Enemy->bIsBoss)
+		{
+			// Bosses target highest damage dealer
+			NewTarget = Enemy->FindHighestDamageDealer();
+		}
+		else if (SpatialGrid)
+		{
+			// Regular enemies target nearest player
+			NewTarget = SpatialGrid->FindNearest(Batch.Positions[i], EWSSpatialCategory::Player);
+		}
+
+		Batch.Targets[i] = NewTarget;
+		Enemy->SetCurrentTarget(NewTarget);
+	}
+}
+
+void UWSEnemyManagerSubsystem::UpdateMovement(FWSEnemyBatch& Batch, float DeltaTime)
+{
+	UWSFlowFieldSubsystem* FlowField = GetWorld()->GetSubsystem<UWSFlowFieldSubsystem>();
+
+	// Steering input is cheap, so it is fed every frame regardless of the update bucket;
+	// the movement component's own tick interval already scales with significance
+	for (int32 i = 0; i < Batch.Num(); ++i)
+	{
+		AActor* Target = Batch.Targets[i].Get();
+		if (!Target)
+		{
+			continue;
+		}
+
+		const FVector Separation = Batch.Separations[i] * SeparationWeight;
+
+		// Enemies in attack range only spread out around the target
+		const FVector ToTarget = Target->GetActorLocation() - Batch.Positions[i];
+		if (ToTarget.SizeSquared2D() <= FMath::Square(Batch.AttackRanges[i]))
+		{
+			if (!Separation.IsNearlyZero())
+			{
+				Batch.Enemies[i]->AddMovementInput(Separation.GetClampedToMaxSize(1.0f));
+			}
+			continue;
+		}
+
+		// Basic enemies follow the shared flow field; bosses and enemies outside it head straight for their target
+		FVector Direction = FVector::ZeroVector;
+		if (FlowField && !Batch.Enemies[i]->bIsBoss)
+		{
+			Direction = FlowField->GetFlowDirection(Batch.Positions[i]);
+		}
+		if (Direction.IsZero())
+		{
+			Direction = ToTarget.GetSafeNormal2D();
+		}
+
+		Batch.Enemies[i]->AddMovementInput((Direction + Separation).GetSafeNormal2D());
+	}
+}
+
+void UWSEnemyManagerSubsystem::UpdateSeparation(FWSEnemyBatch& Batch, float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSEnemySeparation);
+
+	UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (!SpatialGrid)
+	{
+		return;
+	}
+
+	for (int32 i = 0; i < Batch.Num(); ++i)
+	{
+		if (Batch.StepDeltaTimes[i] <= 0.0f)
+		{
+			continue;
+		}
+
+		const FVector& Position = Batch.Positions[i];
+		const int32 Count = SpatialGrid->GatherPackedPositions(Position, SeparationRadius, EWSSpatialCategory::Enemy, NeighbourX, NeighbourY);
+
+		const int32 PaddedCount = Align(Count, 4);
+		for (int32 Pad = Count; Pad < PaddedCount; ++Pad)
+		{
+			NeighbourX.Add(SeparationPadding);
+			NeighbourY.Add(SeparationPadding);
+		}
+
+		const FVector2f Push = ComputeSeparation(Position.X, Position.Y, NeighbourX.GetData(), NeighbourY.GetData(), PaddedCount, SeparationRadius);
+		Batch.Separations[i] = FVector(Push.X, Push.Y, 0.0f);
+	}
+}
+
+void UWSEnemyManagerSubsystem::UpdateAttacks(FWSEnemyBatch& Batch, float DeltaTime)
+{
+	for (int32 i = 0; i < Batch.Num(); ++i)
+	{
+		if (Batch.StepDeltaTimes[i] <= 0.0f)
+		{
+			continue;
+		}
+
+		Batch.AttackTimers[i] = FMath::Max(0.0f, Batch.AttackTimers[i] - Batch.StepDeltaTimes[i]);
+		if (Batch.AttackTimers[i] > 0.0f)
+		{
+			continue;
+		}
+
+		AActor* Target = Batch.Targets[i].Get();
+		if (!Target)
+		{
+			continue;
+		}
+
+		if (FVector::DistSquared(Batch.Positions[i], Target->GetActorLocation()) <= FMath::Square(Batch.AttackRanges[i]))
+		{
+			Batch.Enemies[i]->AttackTarget();
+			Batch.AttackTimers[i] = Batch.AttackCooldowns[i];
+		}
+	}
+}
+
+void UWSEnemyManagerSubsystem::GatherViewers()
+{
+	Viewers.Reset();
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+		if (Pawn)
+		{
+			Viewers.Add({Pawn->GetActorLocation(), PC->GetControlRotation().Vector()});
+		}
+	}
+}
+
+void UWSEnemyManagerSubsystem::UpdateSignificance(FWSEnemyBatch& Batch, float DeltaTime)
+{
+	for (int32 i = 0; i < Batch.Num(); ++i)
+	{
+		// Re-evaluate the bucket on a staggered interval
+		Batch.LODTimers[i] -= DeltaTime;
+		if (Batch.LODTimers[i] <= 0.0f)
+		{
+			Batch.LODTimers[i] += LODEvaluationInterval;
+
+			// Bosses always simulate at full rate
+			const EWSEnemyLOD NewLOD = Batch.Enemies[i]->bIsBoss ? EWSEnemyLOD::Near : EvaluateLOD(Batch.Positions[i], Batch.LODs[i]);
+			if (NewLOD != Batch.LODs[i])
+			{
+				Batch.LODs[i] = NewLOD;
+				ApplyMovementFidelity(Batch.Enemies[i], NewLOD);
+			}
+		}
+
+		LODPopulation[(int32)Batch.LODs[i]]++;
+
+		// Accumulate time until the bucket's update interval has elapsed
+		Batch.UpdateAccumulators[i] += DeltaTime;
+		if (Batch.UpdateAccumulators[i] >= GetLODSettings(Batch.LODs[i]).UpdateInterval)
+		{
+			Batch.StepDeltaTimes[i] = Batch.UpdateAccumulators[i];
+			Batch.UpdateAccumulators[i] = 0.0f;
+		}
+		else
+		{
+			Batch.StepDeltaTimes[i] = 0.0f;
+		}
+	}
+}
+
+EWSEnemyLOD UWSEnemyManagerSubsystem::EvaluateLOD(const FVector& Location, EWSEnemyLOD CurrentLOD) const
+{
+	if (Viewers.Num() == 0)
+	{
+		return CurrentLOD;
+	}
+
+	float NearestDistSq = FLT_MAX;
+	bool bOnScreen = false;
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(OnScreenHalfAngle));
+
+	for (const FViewer& Viewer : Viewers)
+	{
+		const FVector ToEnemy = Location - Viewer.Location;
+		const float DistSq = ToEnemy.SizeSquared();
+		NearestDistSq = FMath::Min(NearestDistSq, DistSq);
+
+		if (FVector::DotProduct(ToEnemy, Viewer.ViewDirection) >= CosHalfAngle * FMath::Sqrt(DistSq))
+		{
+			bOnScreen = true;
+		}
+	}
+
+	const float Distance = FMath::Sqrt(NearestDistSq);
+	const int32 LastLOD = LODSettings.Num() - 1;
+	const int32 Current = FMath::Min((int32)CurrentLOD, LastLOD);
+
+	int32 Target = 0;
+	while (Target < LastLOD && LODSettings[Target].MaxDistance > 0.0f && Distance > LODSettings[Target].MaxDistance)
+	{
+		Target++;
+	}
+
+	// On-screen enemies are one bucket more significant than their distance alone suggests
+	if (bOnScreen && Target > 0)
+	{
+		Target--;
+	}
+
+	// Only cross a boundary once the enemy is clearly past it
+	if (Target > Current && Distance <= LODSettings[Current].MaxDistance + LODHysteresis)
+	{
+		return (EWSEnemyLOD)Current;
+	}
+	if (Target < Current && Distance >= LODSettings[Current - 1].MaxDistance - LODHysteresis && !bOnScreen)
+	{
+		return (EWSEnemyLOD)Current;
+	}
+
+	return (EWSEnemyLOD)Target;
+}
+
+void UWSEnemyManagerSubsystem::ApplyMovementFidelity(AWSEnemyBase* Enemy, EWSEnemyLOD LOD) const
+{
+	const float TickInterval = GetLODSettings(LOD).MovementTickInterval;
+
+	UCharacterMovementComponent* MovementComponent = Enemy->GetCharacterMovement();
+	if (MovementComponent)
+	{
+		MovementComponent->SetComponentTickInterval(TickInterval);
+	}
+
+	USkeletalMeshComponent* MeshComponent = Enemy->GetMesh();
+	if (MeshComponent)
+	{
+		MeshComponent->SetComponentTickInterval(TickInterval);
+	}
+}
+
+const UWSEnemyManagerSubsystem::FSlot* UWSEnemyManagerSubsystem::FindSlot(const FWSEnemyHandle& Handle) const
+{
+	if (!Slots.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
+	}
+
+	const FSlot& Slot = Slots[Handle.Index];
+	if (Slot.Generation != Handle.Generation || Slot.DenseIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return &Slot;
+}
@@ -0,0 +1,140 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSExplosionSubsystem.h"
+#include "WaveSurvival.h"
+#include "WSCharacterBase.h"
+#include "WSDamageSubsystem.h"
+#include "WSEnemyBase.h"
+#include "WSSpatialGridSubsystem.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Explosion Resolve"), STAT_WSExplosionResolve, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Explosions"), STAT_WSPendingExplosions, STATGROUP_WaveSurvival);
+
+#if ENABLE_DRAW_DEBUG
+namespace
+{
+	TAutoConsoleVariable<bool> CVarDrawExplosions(
+		TEXT("ws.Explosion.DrawRadius"),
+		false,
+		TEXT("Draws a debug sphere for the radius of every explosion as it resolves."));
+}
+#endif
+
+UWSExplosionSubsystem::UWSExplosionSubsystem()
+{
+	MaxExplosionsPerFrame = 16;
+	MinFalloffMultiplier = 0.25f;
+	NextExplosion = 0;
+}
+
+bool UWSExplosionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWSExplosionSubsystem::Deinitialize()
+{
+	PendingExplosions.Empty();
+	NextExplosion = 0;
+
+	Super::Deinitialize();
+}
+
+void UWSExplosionSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSExplosionResolve);
+
+	// Oldest first, at most MaxExplosionsPerFrame; chain reactions queued meanwhile wait their turn
+	const int32 EndExplosion = FMath::Min(PendingExplosions.Num(), NextExplosion + FMath::Max(MaxExplosionsPerFrame, 1));
+	while (NextExplosion < EndExplosion)
+	{
+		ResolveExplosion(PendingExplosions[NextExplosion]);
+		NextExplosion++;
+	}
+
+	if (NextExplosion == PendingExplosions.Num())
+	{
+		PendingExplosions.Reset();
+		NextExplosion = 0;
+	}
+
+	SET_DWORD_STAT(STAT_WSPendingExplosions, GetPendingExplosionCount());
+}
+
+TStatId UWSExplosionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWSExplosionSubsystem, STATGROUP_Tickables);
+}
+
+void UWSExplosionSubsystem::QueueExplosion(const FVector& Location, float Radius, float Damage, int32 InstigatorSlot, bool bDamagesPlayers)
+{
+	if (Radius <= 0.0f || Damage <= 0.0f)
+	{
+		return;
+	}
+
+	PendingExplosions.Add({Location, Radius, Damage, InstigatorSlot, bDamagesPlayers});
+}
+
+int32 UWSExplosionSubsystem::GetPendingExplosionCount() const
+{
+	return PendingExplosions.Num() - NextExplosion;
+}
+
+void UWSExplosionSubsystem::ResolveExplosion(const FPendingExplosion& Explosion)
+{
+	UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (!SpatialGrid)
+	{
+		return;
+	}
+
+#if ENABLE_DRAW_DEBUG
+	if (CVarDrawExplosions.GetValueOnGameThread())
+	{
+		DrawDebugSphere(GetWorld(), Explosion.Location, Explosion.Radius, 12, FColor::Orange, false, 1.0f);
+	}
+#endif
+
+	// Enemies are damaged through the queue; any that die and explode are picked up on a later frame
+	UWSDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UWSDamageSubsystem>();
+	if (DamageSubsystem && SpatialGrid->QueryRadius(Explosion.Location, Explosion.Radius, EWSSpatialCategory::Enemy, Candidates) > 0)
+	{
+		for (AActor* Candidate : Candidates)
+		{
+			AWSEnemyBase* Enemy = Cast<AWSEnemyBase>(Candidate);
+			if (!Enemy || Enemy->IsPooled())
+			{
+				continue;
+			}
+
+			FWSDamageEvent Event;
+			Event.Target = Enemy->GetEnemyHandle();
+			Event.Amount = Explosion.Damage * GetFalloffMultiplier(FVector::Dist(Explosion.Location, Enemy->GetActorLocation()), Explosion.Radius);
+			Event.InstigatorSlot = Explosion.InstigatorSlot;
+			DamageSubsystem->QueueDamage(Event);
+		}
+	}
+
+	if (Explosion.bDamagesPlayers && SpatialGrid->QueryRadius(Explosion.Location, Explosion.Radius, EWSSpatialCategory::Player, Candidates) > 0)
+	{
+		for (AActor* Candidate : Candidates)
+		{
+			AWSCharacterBase* Player = Cast<AWSCharacterBase>(Candidate);
+			if (Player)
+			{
+				const float Falloff = GetFalloffMultiplier(FVector::Dist(Explosion.Location, Player->GetActorLocation()), Explosion.Radius);
+				Player->TakeDamageCustom(Explosion.Damage * Falloff, nullptr);
+			}
+		}
+	}
+}
+
+float UWSExplosionSubsystem::GetFalloffMultiplier(float Distance, float Radius) const
+{
+	const float Alpha = FMath::Clamp(Distance / Radius, 0.0f, 1.0f);
+	return FMath::Lerp(1.0f, MinFalloffMultiplier, Alpha);
+}
@@ -0,0 +1,534 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSFlowFieldSubsystem.h"
+#include "WaveSurvival.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "NavigationSystem.h"
+#include "NavigationPath.h"
+
+DECLARE_CYCLE_STAT(TEXT("Flow Field Tick"), STAT_WSFlowFieldTick, STATGROUP_WaveSurvival);
+DECLARE_CYCLE_STAT(TEXT("Flow Field Build"), STAT_WSFlowFieldBuild, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Field Cells Updated"), STAT_WSFlowFieldCellsUpdated, STATGROUP_WaveSurvival);
+
+namespace
+{
+	constexpr uint8 NoDirection = 0xFF;
+
+	// 8-neighbour offsets and the matching unit directions
+	const FIntPoint NeighbourOffsets[8] =
+	{
+		FIntPoint(1, 0), FIntPoint(1, 1), FIntPoint(0, 1), FIntPoint(-1, 1),
+		FIntPoint(-1, 0), FIntPoint(-1, -1), FIntPoint(0, -1), FIntPoint(1, -1)
+	};
+
+	const FVector NeighbourDirections[8] =
+	{
+		FVector(1.0f, 0.0f, 0.0f), FVector(UE_INV_SQRT_2, UE_INV_SQRT_2, 0.0f),
+		FVector(0.0f, 1.0f, 0.0f), FVector(-UE_INV_SQRT_2, UE_INV_SQRT_2, 0.0f),
+		FVector(-1.0f, 0.0f, 0.0f), FVector(-UE_INV_SQRT_2, -UE_INV_SQRT_2, 0.0f),
+		FVector(0.0f, -1.0f, 0.0f), FVector(UE_INV_SQRT_2, -UE_INV_SQRT_2, 0.0f)
+	};
+
+	bool IsCellBlocked(const TArray<uint8>* Blocked, int32 CellIndex)
+	{
+		return Blocked && (*Blocked)[CellIndex] != 0;
+	}
+}
+
+UWSFlowFieldSubsystem::UWSFlowFieldSubsystem()
+{
+	CellSize = 200.0f;
+	GridDimension = 256;
+	ObstacleProbeHeight = 100.0f;
+	ObstacleRowsPerFrame = 8;
+
+	NextObstacleRow = 0;
+	bForceRebuild = false;
+}
+
+bool UWSFlowFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWSFlowFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	BlockedCells.SetNumZeroed(GridDimension * GridDimension);
+	NextObstacleRow = 0;
+}
+
+void UWSFlowFieldSubsystem::Deinitialize()
+{
+	BuildTask.Wait();
+
+	CurrentField.Reset();
+	PendingField.Reset();
+	BlockedSnapshot.Reset();
+
+	Super::Deinitialize();
+}
+
+void UWSFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSFlowFieldTick);
+
+	ProbeObstacleRows();
+
+	// Swap in a finished build
+	if (PendingField.IsValid() && BuildTask.IsCompleted())
+	{
+		CurrentField = PendingField;
+		PendingField.Reset();
+
+		SET_DWORD_STAT(STAT_WSFlowFieldCellsUpdated, CurrentField->CellsUpdated);
+	}
+
+	if (PendingField.IsValid())
+	{
+		return;
+	}
+
+	GatherGoalCells(GoalCells);
+	if (GoalCells.Num() > 0 && (bForceRebuild || GoalCells != BuiltGoalCells))
+	{
+		StartBuild();
+	}
+}
+
+TStatId UWSFlowFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWSFlowFieldSubsystem, STATGROUP_Tickables);
+}
+
+FVector UWSFlowFieldSubsystem::GetFlowDirection(FVector Location) const
+{
+	if (!CurrentField.IsValid())
+	{
+		return FVector::ZeroVector;
+	}
+
+	const int32 CellIndex = GetCellIndex(Location);
+	if (CellIndex == INDEX_NONE)
+	{
+		return FVector::ZeroVector;
+	}
+
+	const uint8 Direction = CurrentField->Directions[CellIndex];
+	return Direction == NoDirection ? FVector::ZeroVector : NeighbourDirections[Direction];
+}
+
+bool UWSFlowFieldSubsystem::HasFlowField() const
+{
+	return CurrentField.IsValid();
+}
+
+void UWSFlowFieldSubsystem::InvalidateFlowField()
+{
+	bForceRebuild = true;
+}
+
+FVector2D UWSFlowFieldSubsystem::GetGridOrigin() const
+{
+	const float HalfExtent = GridDimension * CellSize * 0.5f;
+	return FVector2D(-HalfExtent, -HalfExtent);
+}
+
+int32 UWSFlowFieldSubsystem::GetCellIndex(const FVector& Location) const
+{
+	const FVector2D Origin = GetGridOrigin();
+	const int32 X = FMath::FloorToInt((Location.X - Origin.X) / CellSize);
+	const int32 Y = FMath::FloorToInt((Location.Y - Origin.Y) / CellSize);
+
+	if (X < 0 || Y < 0 || X >= GridDimension || Y >= GridDimension)
+	{
+		return INDEX_NONE;
+	}
+
+	return Y * GridDimension + X;
+}
+
+void UWSFlowFieldSubsystem::ProbeObstacleRows()
+{
+	if (NextObstacleRow >= GridDimension || BlockedCells.Num() == 0)
+	{
+		return;
+	}
+
+	const FVector2D Origin = GetGridOrigin();
+	const FCollisionShape Probe = FCollisionShape::MakeBox(FVector(CellSize * 0.45f, CellSize * 0.45f, 50.0f));
+	const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+
+	const int32 LastRow = FMath::Min(NextObstacleRow + ObstacleRowsPerFrame, GridDimension);
+	for (int32 Y = NextObstacleRow; Y < LastRow; ++Y)
+	{
+		for (int32 X = 0; X < GridDimension; ++X)
+		{
+			const FVector CellCenter(
+				Origin.X + (X + 0.5f) * CellSize,
+				Origin.Y + (Y + 0.5f) * CellSize,
+				ObstacleProbeHeight);
+
+			BlockedCells[Y * GridDimension + X] =
+				GetWorld()->OverlapAnyTestByObjectType(CellCenter, FQuat::Identity, ObjectParams, Probe) ? 1 : 0;
+		}
+	}
+	NextObstacleRow = LastRow;
+
+	// Publish the finished mask to the worker builds and rebuild against it
+	if (NextObstacleRow >= GridDimension)
+	{
+		BlockedSnapshot = MakeShared<const TArray<uint8>, ESPMode::ThreadSafe>(BlockedCells);
+		bForceRebuild = true;
+
+		UE_LOG(LogTemp, Log, TEXT("Flow field obstacle mask built (%dx%d cells)"), GridDimension, GridDimension);
+	}
+}
+
+void UWSFlowFieldSubsystem::GatherGoalCells(TArray<int32>& OutGoalCells) const
+{
+	OutGoalCells.Reset();
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+		if (Pawn)
+		{
+			const int32 CellIndex = GetCellIndex(Pawn->GetActorLocation());
+			if (CellIndex != INDEX_NONE)
+			{
+				OutGoalCells.AddUnique(CellIndex);
+			}
+		}
+	}
+
+	OutGoalCells.Sort();
+}
+
+void UWSFlowFieldSubsystem::StartBuild()
+{
+	// The current field was built for BuiltGoalCells, so it can be repaired unless the obstacles changed
+	const bool bRepair = !bForceRebuild && CurrentField.IsValid();
+	TSharedPtr<const FFlowField, ESPMode::ThreadSafe> Previous = bRepair ? CurrentField : nullptr;
+	TArray<int32> PreviousGoals = bRepair ? BuiltGoalCells : TArray<int32>();
+
+	BuiltGoalCells = GoalCells;
+	bForceRebuild = false;
+
+	TSharedPtr<FFlowField, ESPMode::ThreadSafe> Field = MakeShared<FFlowField, ESPMode::ThreadSafe>();
+	PendingField = Field;
+
+	const int32 Dimension = GridDimension;
+	TArray<int32> Goals = GoalCells;
+	TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Blocked = BlockedSnapshot;
+
+	BuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Field, Previous, Dimension, PreviousGoals = MoveTemp(PreviousGoals), Goals = MoveTemp(Goals), Blocked]()
+	{
+		if (Previous.IsValid())
+		{
+			*Field = *Previous;
+			RepairField(*Field, Dimension, PreviousGoals, Goals, Blocked.Get());
+		}
+		else
+		{
+			BuildField(*Field, Dimension, Goals, Blocked.Get());
+		}
+	});
+}
+
+void UWSFlowFieldSubsystem::BuildField(FFlowField& OutField, int32 Dimension, const TArray<int32>& Goals, const TArray<uint8>* Blocked)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSFlowFieldBuild);
+
+	const int32 NumCells = Dimension * Dimension;
+
+	// Breadth-first integration field from every goal cell at once
+	OutField.Distance.Init(MAX_int32, NumCells);
+	OutField.Owner.Init(INDEX_NONE, NumCells);
+
+	TArray<FFrontierCell> Seeds;
+	for (int32 Goal : Goals)
+	{
+		OutField.Distance[Goal] = 0;
+		OutField.Owner[Goal] = Goal;
+		Seeds.Add({Goal, 0});
+	}
+
+	TArray<int32> Changed;
+	PropagateDistances(OutField, Dimension, Seeds, Blocked, Changed);
+
+	OutField.Directions.Init(NoDirection, NumCells);
+	for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+	{
+		OutField.Directions[CellIndex] = ComputeDirection(OutField.Distance, Dimension, CellIndex, Blocked);
+	}
+
+	OutField.CellsUpdated = NumCells;
+}
+
+void UWSFlowFieldSubsystem::RepairField(FFlowField& Field, int32 Dimension, const TArray<int32>& PreviousGoals, const TArray<int32>& Goals, const TArray<uint8>* Blocked)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSFlowFieldBuild);
+
+	// Forget every cell a departed goal was nearest to. Each cell is reached through a
+	// cardinal neighbour with the same owner, so the region floods from the goal itself.
+	TArray<int32> Changed;
+	for (int32 Goal : PreviousGoals)
+	{
+		if (Goals.Contains(Goal) || Field.Owner[Goal] != Goal)
+		{
+			continue;
+		}
+
+		int32 Head = Changed.Num();
+		Field.Distance[Goal] = MAX_int32;
+		Field.Owner[Goal] = INDEX_NONE;
+		Changed.Add(Goal);
+
+		for (; Head < Changed.Num(); ++Head)
+		{
+			const int32 CellIndex = Changed[Head];
+			const int32 X = CellIndex % Dimension;
+			const int32 Y = CellIndex / Dimension;
+
+			for (int32 Dir = 0; Dir < 8; Dir += 2)
+			{
+				const int32 NX = X + NeighbourOffsets[Dir].X;
+				const int32 NY = Y + NeighbourOffsets[Dir].Y;
+				if (NX < 0 || NY < 0 || NX >= Dimension || NY >= Dimension)
+				{
+					continue;
+				}
+
+				const int32 NeighbourIndex = NY * Dimension + NX;
+				if (Field.Owner[NeighbourIndex] == Goal)
+				{
+					Field.Distance[NeighbourIndex] = MAX_int32;
+					Field.Owner[NeighbourIndex] = INDEX_NONE;
+					Changed.Add(NeighbourIndex);
+				}
+			}
+		}
+	}
+
+	// Refill from the cells bordering the forgotten region, which still hold correct distances
+	TArray<FFrontierCell> Seeds;
+	for (int32 CellIndex : Changed)
+	{
+		const int32 X = CellIndex % Dimension;
+		const int32 Y = CellIndex / Dimension;
+
+		for (int32 Dir = 0; Dir < 8; Dir += 2)
+		{
+			const int32 NX = X + NeighbourOffsets[Dir].X;
+			const int32 NY = Y + NeighbourOffsets[Dir].Y;
+			if (NX < 0 || NY < 0 || NX >= Dimension || NY >= Dimension)
+			{
+				continue;
+			}
+
+			const int32 NeighbourIndex = NY * Dimension + NX;
+			if (Field.Distance[NeighbourIndex] != MAX_int32)
+			{
+				Seeds.Add({NeighbourIndex, Field.Distance[NeighbourIndex]});
+			}
+		}
+	}
+
+	// New goals only lower distances, so they spread just as far as they are the nearest goal
+	for (int32 Goal : Goals)
+	{
+		if (!PreviousGoals.Contains(Goal))
+		{
+			Field.Distance[Goal] = 0;
+			Field.Owner[Goal] = Goal;
+			Seeds.Add({Goal, 0});
+			Changed.Add(Goal);
+		}
+	}
+
+	PropagateDistances(Field, Dimension, Seeds, Blocked, Changed);
+
+	// A cell's direction depends on its neighbours' distances
+	for (int32 CellIndex : Changed)
+	{
+		const int32 X = CellIndex % Dimension;
+		const int32 Y = CellIndex / Dimension;
+
+		Field.Directions[CellIndex] = ComputeDirection(Field.Distance, Dimension, CellIndex, Blocked);
+		for (int32 Dir = 0; Dir < 8; ++Dir)
+		{
+			const int32 NX = X + NeighbourOffsets[Dir].X;
+			const int32 NY = Y + NeighbourOffsets[Dir].Y;
+			if (NX >= 0 && NY >= 0 && NX < Dimension && NY < Dimension)
+			{
+				const int32 NeighbourIndex = NY * Dimension + NX;
+				Field.Directions[NeighbourIndex] = ComputeDirection(Field.Distance, Dimension, NeighbourIndex, Blocked);
+			}
+		}
+	}
+
+	Field.CellsUpdated = Changed.Num();
+}
+
+void UWSFlowFieldSubsystem::PropagateDistances(FFlowField& Field, int32 Dimension, TArray<FFrontierCell>& Seeds, const TArray<uint8>* Blocked, TArray<int32>& OutChanged)
+{
+	// Steps cost 1, so merging the sorted seeds with a FIFO of relaxed cells visits
+	// cells in distance order without a priority queue
+	Seeds.Sort([](const FFrontierCell& A, const FFrontierCell& B)
+	{
+		return A.Distance < B.Distance;
+	});
+
+	TArray<FFrontierCell> Queue;
+	Queue.Reserve(Field.Distance.Num());
+
+	int32 SeedHead = 0;
+	int32 QueueHead = 0;
+	while (SeedHead < Seeds.Num() || QueueHead < Queue.Num())
+	{
+		const bool bTakeSeed = QueueHead == Queue.Num() || (SeedHead < Seeds.Num() && Seeds[SeedHead].Distance <= Queue[QueueHead].Distance);
+		const FFrontierCell Current = bTakeSeed ? Seeds[SeedHead++] : Queue[QueueHead++];
+
+		// Lowered again since it was queued
+		if (Field.Distance[Current.CellIndex] != Current.Distance)
+		{
+			continue;
+		}
+
+		const int32 X = Current.CellIndex % Dimension;
+		const int32 Y = Current.CellIndex / Dimension;
+
+		// Cardinal neighbours only so the field doesn't cut corners of obstacles
+		for (int32 Dir = 0; Dir < 8; Dir += 2)
+		{
+			const int32 NX = X + NeighbourOffsets[Dir].X;
+			const int32 NY = Y + NeighbourOffsets[Dir].Y;
+			if (NX < 0 || NY < 0 || NX >= Dimension || NY >= Dimension)
+			{
+				continue;
+			}
+
+			const int32 NeighbourIndex = NY * Dimension + NX;
+			if (Current.Distance + 1 < Field.Distance[NeighbourIndex] && !IsCellBlocked(Blocked, NeighbourIndex))
+			{
+				Field.Distance[NeighbourIndex] = Current.Distance + 1;
+				Field.Owner[NeighbourIndex] = Field.Owner[Current.CellIndex];
+				Queue.Add({NeighbourIndex, Current.Distance + 1});
+				OutChanged.Add(NeighbourIndex);
+			}
+		}
+	}
+}
+
+uint8 UWSFlowFieldSubsystem::ComputeDirection(const TArray<int32>& Distance, int32 Dimension, int32 CellIndex, const TArray<uint8>* Blocked)
+{
+	// Each cell points at its lowest-distance neighbour
+	const int32 CellDistance = Distance[CellIndex];
+	if (CellDistance == 0 || CellDistance == MAX_int32)
+	{
+		return NoDirection;
+	}
+
+	const int32 X = CellIndex % Dimension;
+	const int32 Y = CellIndex / Dimension;
+	int32 BestDistance = CellDistance;
+	uint8 BestDirection = NoDirection;
+
+	for (int32 Dir = 0; Dir < 8; ++Dir)
+	{
+		const int32 NX = X + NeighbourOffsets[Dir].X;
+		const int32 NY = Y + NeighbourOffsets[Dir].Y;
+		if (NX < 0 || NY < 0 || NX >= Dimension || NY >= Dimension)
+		{
+			continue;
+		}
+
+		// Diagonal steps are only allowed when both adjacent cardinal cells are open
+		if ((Dir & 1) != 0 && (IsCellBlocked(Blocked, Y * Dimension + NX) || IsCellBlocked(Blocked, NY * Dimension + X)))
+		{
+			continue;
+		}
+
+		const int32 NeighbourDistance = Distance[NY * Dimension + NX];
+		if (NeighbourDistance < BestDistance)
+		{
+			BestDistance = NeighbourDistance;
+			BestDirection = (uint8)Dir;
+		}
+	}
+
+	return BestDirection;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs GWSFlowFieldBenchmarkCommand(
+	TEXT("ws.FlowField.Benchmark"),
+	TEXT("Compares flow field sampling against per-agent navmesh path queries. Usage: ws.FlowField.Benchmark [AgentCount...] (default 250 1000 4000)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UWSFlowFieldSubsystem* FlowField = World ? World->GetSubsystem<UWSFlowFieldSubsystem>() : nullptr;
+		if (!FlowField)
+		{
+			return;
+		}
+
+		TArray<int32> AgentCounts;
+		for (const FString& Arg : Args)
+		{
+			AgentCounts.Add(FCString::Atoi(*Arg));
+		}
+		if (AgentCounts.Num() == 0)
+		{
+			AgentCounts = {250, 1000, 4000};
+		}
+
+		// Path toward the first player, or the origin without one
+		FVector Goal = FVector::ZeroVector;
+		APlayerController* PC = World->GetFirstPlayerController();
+		if (PC && PC->GetPawn())
+		{
+			Goal = PC->GetPawn()->GetActorLocation();
+		}
+
+		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		FRandomStream Random(1234);
+
+		for (int32 AgentCount : AgentCounts)
+		{
+			TArray<FVector> Agents;
+			Agents.Reserve(AgentCount);
+			for (int32 i = 0; i < AgentCount; ++i)
+			{
+				Agents.Add(Goal + FVector(Random.FRandRange(-10000.0f, 10000.0f), Random.FRandRange(-10000.0f, 10000.0f), 0.0f));
+			}
+
+			double StartTime = FPlatformTime::Seconds();
+			FVector Checksum = FVector::ZeroVector;
+			for (const FVector& Agent : Agents)
+			{
+				Checksum += FlowField->GetFlowDirection(Agent);
+			}
+			const double FlowFieldMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			double NavMs = -1.0;
+			if (NavSys)
+			{
+				StartTime = FPlatformTime::Seconds();
+				for (const FVector& Agent : Agents)
+				{
+					NavSys->FindPathToLocationSynchronously(World, Agent, Goal);
+				}
+				NavMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			}
+
+			UE_LOG(LogTemp, Log, TEXT("Flow field benchmark - %d agents: flow field %.3f ms, navmesh paths %.3f ms (checksum %s)"),
+				AgentCount, FlowFieldMs, NavMs, *Checksum.ToString());
+		}
+	}));
+#endif
@@ -1,12 +1,18 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "WSGameMode.h"
+#include "WaveSurvival.h"
 #include "WSGameState.h"
 #include "WSPlayerController.h"
 #include "WSPlayerState.h"
+#include "WSSpatialGridSubsystem.h"
+#include "WSMassEnemySubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "EngineUtils.h"
 
+DECLARE_CYCLE_STAT(TEXT("Spawn Queue"), STAT_WSSpawnQueue, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Spawns"), STAT_WSPendingSpawns, STATGROUP_WaveSurvival);
+
 AWSGameMode::AWSGameMode()
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -16,6 +22,7 @@ AWSGameMode::AWSGameMode()
 	PlayerStateClass = AWSPlayerState::StaticClass();
 
 	SpawnRadius = 2000.0f;
+	SpawnQueueHead = 0;
 }
 
 void AWSGameMode::BeginPlay()
@@ -32,6 +39,37 @@ void AWSGameMode::BeginPlay()
 void AWSGameMode::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	ProcessSpawnQueue();
+
+	// Prewarming shares the spawn budget and only runs while no wave is being spawned
+	if (!IsSpawningWave())
+	{
+		ProcessPoolPrewarm();
+	}
+}
+
+void AWSGameMode::PostLogin(APlayerController* NewPlayer)
+{
+	Super::PostLogin(NewPlayer);
+
+	// Give the player a fixed slot for per-player bookkeeping such as damage ledgers
+	AWSGameState* State = GetGameState<AWSGameState>();
+	if (State && NewPlayer)
+	{
+		State->AssignPlayerSlot(NewPlayer->GetPlayerState<AWSPlayerState>());
+	}
+}
+
+void AWSGameMode::Logout(AController* Exiting)
+{
+	AWSGameState* State = GetGameState<AWSGameState>();
+	if (State && Exiting)
+	{
+		State->ReleasePlayerSlot(Exiting->GetPlayerState<AWSPlayerState>());
+	}
+
+	Super::Logout(Exiting);
 }
 
 void AWSGameMode::InitializeGame(EWSGameMode InGameMode, EWSDifficulty InDifficulty)
@@ -81,63 +119,287 @@ void AWSGameMode::SpawnWaveEnemies()
 	}
 	else
 	{
-		// Spawn regular enemies based on composition
+		// Queue regular enemies; they are spawned over the next frames under the spawn budget
 		int32 TotalEnemiesToSpawn = WSGameState->TotalEnemiesThisWave;
-		
-		// Calculate exact spawn counts with proper distribution to avoid over-spawning
-		// due to rounding up multiple times
-		struct FEnemySpawnInfo
-		{
-			EWSEnemyType EnemyType;
-			int32 BaseCount;
-			float Remainder;
-		};
-		
-		TArray<FEnemySpawnInfo> SpawnInfos;
-		int32 TotalBaseCount = 0;
-		
-		// Step 1: Calculate base counts and remainders
-		for (const TPair<EWSEnemyType, float>& Composition : WaveConfig.EnemyComposition)
+
+		SpawnQueue.Reset();
+		SpawnQueueHead = 0;
+		BuildSpawnManifest(WaveConfig, TotalEnemiesToSpawn, SpawnQueue);
+
+		UE_LOG(LogTemp, Log, TEXT("Queued %d enemies for wave %d"), 
+			SpawnQueue.Num(), WSGameState->CurrentWaveNumber);
+	}
+}
+
+void AWSGameMode::ComputeSpawnCounts(const FWSWaveConfig& WaveConfig, int32 TotalEnemies, TMap<EWSEnemyType, int32>& OutCounts) const
+{
+	// Calculate exact spawn counts with proper distribution to avoid over-spawning
+	// due to rounding up multiple times
+	struct FEnemySpawnInfo
+	{
+		EWSEnemyType EnemyType;
+		int32 BaseCount;
+		float Remainder;
+	};
+	
+	TArray<FEnemySpawnInfo> SpawnInfos;
+	int32 TotalBaseCount = 0;
+	
+	// Step 1: Calculate base counts and remainders
+	for (const TPair<EWSEnemyType, float>& Composition : WaveConfig.EnemyComposition)
+	{
+		float ExactCount = TotalEnemies * Composition.Value;
+		int32 BaseCount = FMath::FloorToInt(ExactCount);
+		float Remainder = ExactCount - BaseCount;
+		SpawnInfos.Add({Composition.Key, BaseCount, Remainder});
+		TotalBaseCount += BaseCount;
+	}
+	
+	// Step 2: Distribute remaining enemies based on largest remainders
+	int32 Remaining = TotalEnemies - TotalBaseCount;
+	SpawnInfos.StableSort([](const FEnemySpawnInfo& A, const FEnemySpawnInfo& B) {
+		return A.Remainder > B.Remainder;
+	});
+	
+	for (int32 i = 0; i < Remaining && i < SpawnInfos.Num(); ++i)
+	{
+		SpawnInfos[i].BaseCount += 1;
+	}
+
+	for (const FEnemySpawnInfo& Info : SpawnInfos)
+	{
+		OutCounts.Add(Info.EnemyType, Info.BaseCount);
+	}
+}
+
+void AWSGameMode::BuildSpawnManifest(const FWSWaveConfig& WaveConfig, int32 TotalEnemies, TArray<EWSEnemyType>& OutManifest) const
+{
+	TMap<EWSEnemyType, int32> SpawnCounts;
+	ComputeSpawnCounts(WaveConfig, TotalEnemies, SpawnCounts);
+
+	// Write one manifest entry per enemy
+	OutManifest.Reserve(OutManifest.Num() + TotalEnemies);
+	for (const TPair<EWSEnemyType, int32>& Count : SpawnCounts)
+	{
+		for (int32 i = 0; i < Count.Value; i++)
 		{
-			float ExactCount = TotalEnemiesToSpawn * Composition.Value;
-			int32 BaseCount = FMath::FloorToInt(ExactCount);
-			float Remainder = ExactCount - BaseCount;
-			SpawnInfos.Add({Composition.Key, BaseCount, Remainder});
-			TotalBaseCount += BaseCount;
+			OutManifest.Add(Count.Key);
 		}
-		
-		// Step 2: Distribute remaining enemies based on largest remainders
-		int32 Remaining = TotalEnemiesToSpawn - TotalBaseCount;
-		SpawnInfos.StableSort([](const FEnemySpawnInfo& A, const FEnemySpawnInfo& B) {
-			return A.Remainder > B.Remainder;
-		});
-		
-		for (int32 i = 0; i < Remaining && i < SpawnInfos.Num(); ++i)
+	}
+
+	// Shuffle so a partially drained queue already has the wave's mix of enemy types
+	for (int32 i = OutManifest.Num() - 1; i > 0; --i)
+	{
+		const int32 SwapIndex = FMath::RandRange(0, i);
+		OutManifest.Swap(i, SwapIndex);
+	}
+}
+
+void AWSGameMode::ProcessSpawnQueue()
+{
+	SET_DWORD_STAT(STAT_WSPendingSpawns, GetPendingSpawnCount());
+
+	if (SpawnQueueHead >= SpawnQueue.Num())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_WSSpawnQueue);
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 SpawnedThisFrame = 0;
+
+	// Always spawn at least one enemy per frame so the queue makes progress
+	while (SpawnQueueHead < SpawnQueue.Num())
+	{
+		FVector SpawnLocation = GetRandomSpawnLocation();
+		SpawnEnemy(SpawnQueue[SpawnQueueHead], SpawnLocation);
+		SpawnQueueHead++;
+		SpawnedThisFrame++;
+
+		if (IsSpawnBudgetExhausted(SpawnedThisFrame, StartTime))
 		{
-			SpawnInfos[i].BaseCount += 1;
+			break;
 		}
-		
-		// Step 3: Spawn enemies with correct counts
-		for (const FEnemySpawnInfo& Info : SpawnInfos)
+	}
+
+	if (SpawnQueueHead >= SpawnQueue.Num())
+	{
+		UE_LOG(LogTemp, Log, TEXT("Spawned %d enemies for wave %d"), 
+			SpawnQueue.Num(), WSGameState ? WSGameState->CurrentWaveNumber : 0);
+
+		SpawnQueue.Reset();
+		SpawnQueueHead = 0;
+	}
+}
+
+void AWSGameMode::ProcessPoolPrewarm()
+{
+	if (PoolPrewarmTargets.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_WSSpawnQueue);
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 SpawnedThisFrame = 0;
+
+	for (auto It = PoolPrewarmTargets.CreateIterator(); It; ++It)
+	{
+		FWSEnemyPool& Pool = EnemyPools.FindOrAdd(It.Key());
+
+		while (Pool.InactiveEnemies.Num() < It.Value())
 		{
-			for (int32 i = 0; i < Info.BaseCount; i++)
+			AWSEnemyBase* Enemy = SpawnEnemyActor(It.Key(), FVector::ZeroVector);
+			if (!Enemy)
+			{
+				// No class configured for this type, nothing to prewarm
+				It.Value() = 0;
+				break;
+			}
+
+			Enemy->DeactivateToPool();
+			Pool.InactiveEnemies.Add(Enemy);
+			SpawnedThisFrame++;
+
+			if (IsSpawnBudgetExhausted(SpawnedThisFrame, StartTime))
 			{
-				FVector SpawnLocation = GetRandomSpawnLocation();
-				SpawnEnemy(Info.EnemyType, SpawnLocation);
+				return;
 			}
 		}
-		
-		UE_LOG(LogTemp, Log, TEXT("Spawned %d enemies for wave %d"), 
-			TotalEnemiesToSpawn, WSGameState->CurrentWaveNumber);
+
+		It.RemoveCurrent();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Enemy pools prewarmed"));
+}
+
+bool AWSGameMode::IsSpawnBudgetExhausted(int32 SpawnedThisFrame, double StartTime) const
+{
+	if (MaxSpawnsPerFrame > 0 && SpawnedThisFrame >= MaxSpawnsPerFrame)
+	{
+		return true;
+	}
+
+	return SpawnTimeBudgetMs > 0.0f && (FPlatformTime::Seconds() - StartTime) * 1000.0 >= SpawnTimeBudgetMs;
+}
+
+bool AWSGameMode::IsSpawningWave() const
+{
+	return SpawnQueueHead < SpawnQueue.Num();
+}
+
+int32 AWSGameMode::GetPendingSpawnCount() const
+{
+	return SpawnQueue.Num() - SpawnQueueHead;
+}
+
+float AWSGameMode::GetSpawnProgress() const
+{
+	if (SpawnQueue.Num() == 0)
+	{
+		return 1.0f;
 	}
+
+	return (float)SpawnQueueHead / (float)SpawnQueue.Num();
 }
 
 void AWSGameMode::SpawnEnemy(EWSEnemyType EnemyType, FVector SpawnLocation)
+{
+	// Basic enemies spawned away from players start out as Mass entities
+	UWSMassEnemySubsystem* MassEnemies = GetWorld()->GetSubsystem<UWSMassEnemySubsystem>();
+	if (MassEnemies && MassEnemies->ShouldSimulateAsEntity(EnemyType, SpawnLocation))
+	{
+		MassEnemies->SpawnEntity(EnemyType, SpawnLocation);
+		return;
+	}
+
+	AcquireEnemy(EnemyType, SpawnLocation);
+}
+
+AWSEnemyBase* AWSGameMode::AcquireEnemy(EWSEnemyType EnemyType, FVector SpawnLocation)
+{
+	// Reuse a pooled enemy when one is available
+	FWSEnemyPool* Pool = EnemyPools.Find(EnemyType);
+	while (Pool && Pool->InactiveEnemies.Num() > 0)
+	{
+		AWSEnemyBase* Enemy = Pool->InactiveEnemies.Pop(EAllowShrinking::No);
+		if (IsValid(Enemy))
+		{
+			Enemy->ActivateFromPool(SpawnLocation, FRotator::ZeroRotator);
+			return Enemy;
+		}
+	}
+
+	return SpawnEnemyActor(EnemyType, SpawnLocation);
+}
+
+void AWSGameMode::ReleaseEnemy(AWSEnemyBase* Enemy)
+{
+	if (!IsValid(Enemy) || Enemy->IsPooled())
+	{
+		return;
+	}
+
+	Enemy->DeactivateToPool();
+	EnemyPools.FindOrAdd(Enemy->EnemyType).InactiveEnemies.Add(Enemy);
+}
+
+void AWSGameMode::PrewarmEnemyPools(int32 WaveNumber)
+{
+	if (!WSGameState)
+	{
+		return;
+	}
+
+	FWSWaveConfig WaveConfig = GetWaveConfig(WaveNumber);
+	if (WaveConfig.bIsBossWave)
+	{
+		return;
+	}
+
+	TMap<EWSEnemyType, int32> SpawnCounts;
+	ComputeSpawnCounts(WaveConfig, WSGameState->CalculateEnemyCountForWave(WaveNumber), SpawnCounts);
+
+	UWSMassEnemySubsystem* MassEnemies = GetWorld()->GetSubsystem<UWSMassEnemySubsystem>();
+
+	for (const TPair<EWSEnemyType, int32>& Count : SpawnCounts)
+	{
+		// Entity-simulated types never need more actors than can be promoted at once
+		int32 Target = Count.Value;
+		if (MassEnemies && MassEnemies->IsEntityEnemyType(Count.Key))
+		{
+			Target = FMath::Min(Target, MassEnemies->GetMaxPromotedActors());
+		}
+
+		if (Target > GetPooledEnemyCount(Count.Key))
+		{
+			PoolPrewarmTargets.Add(Count.Key, Target);
+		}
+	}
+	
+	UE_LOG(LogTemp, Log, TEXT("Prewarming enemy pools for wave %d"), WaveNumber);
+}
+
+int32 AWSGameMode::GetPooledEnemyCount(EWSEnemyType EnemyType) const
+{
+	const FWSEnemyPool* Pool = EnemyPools.Find(EnemyType);
+	return Pool ? Pool->InactiveEnemies.Num() : 0;
+}
+
+TSubclassOf<AWSEnemyBase> AWSGameMode::GetEnemyClass(EWSEnemyType EnemyType) const
+{
+	const TSubclassOf<AWSEnemyBase>* EnemyClass = EnemyClasses.Find(EnemyType);
+	return EnemyClass ? *EnemyClass : nullptr;
+}
+
+AWSEnemyBase* AWSGameMode::SpawnEnemyActor(EWSEnemyType EnemyType, const FVector& SpawnLocation)
 {
 	if (!EnemyClasses.Contains(EnemyType))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("No class defined for enemy type %d"), (int32)EnemyType);
-		return;
+		return nullptr;
 	}
 
 	TSubclassOf<class AWSEnemyBase> EnemyClass = EnemyClasses[EnemyType];
@@ -145,13 +407,13 @@ void AWSGameMode::SpawnEnemy(EWSEnemyType EnemyType, FVector SpawnLocation)
 	if (!EnemyClass)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Invalid enemy class for type %d"), (int32)EnemyType);
-		return;
+		return nullptr;
 	}
 
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-	GetWorld()->SpawnActor<AActor>(EnemyClass, SpawnLocation, FRotator::ZeroRotator, SpawnParams);
+	return GetWorld()->SpawnActor<AWSEnemyBase>(EnemyClass, SpawnLocation, FRotator::ZeroRotator, SpawnParams);
 }
 
 void AWSGameMode::PlayerDowned(AController* Player)
@@ -247,9 +509,27 @@ FVector AWSGameMode::GetBossSpawnLocation()
 FVector AWSGameMode::GetSafeRespawnLocation()
 {
 	// Find location with fewest enemies nearby
-	// For MVP, return a location far from enemies
+	UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (!SpatialGrid)
+	{
+		return GetRandomSpawnLocation();
+	}
+
+	FVector SafestLocation = GetRandomSpawnLocation();
+	int32 FewestEnemies = SpatialGrid->CountInRadius(SafestLocation, SafeRespawnCheckRadius, EWSSpatialCategory::Enemy);
+
+	for (int32 i = 1; i < SafeRespawnCandidates && FewestEnemies > 0; i++)
+	{
+		FVector Candidate = GetRandomSpawnLocation();
+		int32 EnemyCount = SpatialGrid->CountInRadius(Candidate, SafeRespawnCheckRadius, EWSSpatialCategory::Enemy);
+		if (EnemyCount < FewestEnemies)
+		{
+			FewestEnemies = EnemyCount;
+			SafestLocation = Candidate;
+		}
+	}
 	
-	return GetRandomSpawnLocation();
+	return SafestLocation;
 }
 
 void AWSGameMode::SetupWaveConfigurations()
@@ -1,6 +1,8 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "WSGameState.h"
+#include "WSGameMode.h"
+#include "WSPlayerState.h"
 #include "Net/UnrealNetwork.h"
 
 AWSGameState::AWSGameState()
@@ -23,6 +25,11 @@ AWSGameState::AWSGameState()
 	
 	bGameOver = false;
 	bVictory = false;
+
+	for (int32 Slot = 0; Slot < WSMaxPlayers; ++Slot)
+	{
+		SlotPlayerStates[Slot] = nullptr;
+	}
 }
 
 void AWSGameState::BeginPlay()
@@ -60,24 +67,11 @@ void AWSGameState::StartNextWave()
 	CurrentPhase = EWSWavePhase::Combat;
 	
 	// Calculate enemies based on game mode and wave number
-	if (GameMode == EWSGameMode::MainMode)
-	{
-		if (CurrentWaveNumber == 10)
-		{
-			CurrentPhase = EWSWavePhase::BossFight;
-			TotalEnemiesThisWave = 1; // Boss only
-		}
-		else
-		{
-			TotalEnemiesThisWave = BaseEnemyCountPerPlayer * ActivePlayerCount;
-		}
-	}
-	else // Survival Mode
+	if (GameMode == EWSGameMode::MainMode && CurrentWaveNumber == 10)
 	{
-		// Scaling formula for survival
-		float WaveMultiplier = 1.0f + (CurrentWaveNumber * 0.15f);
-		TotalEnemiesThisWave = FMath::CeilToInt(BaseEnemyCountPerPlayer * ActivePlayerCount * WaveMultiplier);
+		CurrentPhase = EWSWavePhase::BossFight;
 	}
+	TotalEnemiesThisWave = CalculateEnemyCountForWave(CurrentWaveNumber);
 	
 	RemainingEnemies = TotalEnemiesThisWave;
 	
@@ -108,6 +102,16 @@ void AWSGameState::StartShopPhase()
 {
 	CurrentPhase = EWSWavePhase::PreWave;
 	ShopTimeRemaining = ShopPhaseDuration;
+
+	// Fill enemy pools for the upcoming wave while players are shopping
+	if (HasAuthority())
+	{
+		AWSGameMode* WSGameMode = GetWorld()->GetAuthGameMode<AWSGameMode>();
+		if (WSGameMode)
+		{
+			WSGameMode->PrewarmEnemyPools(CurrentWaveNumber + 1);
+		}
+	}
 	
 	UE_LOG(LogTemp, Log, TEXT("Shop phase started - %f seconds"), ShopPhaseDuration);
 }
@@ -131,6 +135,91 @@ void AWSGameState::EnemyKilled()
 	}
 }
 
+int32 AWSGameState::CalculateEnemyCountForWave(int32 WaveNumber) const
+{
+	if (GameMode == EWSGameMode::MainMode)
+	{
+		if (WaveNumber == 10)
+		{
+			return 1; // Boss only
+		}
+
+		return BaseEnemyCountPerPlayer * ActivePlayerCount;
+	}
+
+	// Scaling formula for survival
+	float WaveMultiplier = 1.0f + (WaveNumber * 0.15f);
+	return FMath::CeilToInt(BaseEnemyCountPerPlayer * ActivePlayerCount * WaveMultiplier);
+}
+
+bool AWSGameState::AssignPlayerSlot(AWSPlayerState* PlayerState)
+{
+	if (!PlayerState)
+	{
+		return false;
+	}
+
+	for (int32 Slot = 0; Slot < WSMaxPlayers; ++Slot)
+	{
+		if (!SlotPlayerStates[Slot])
+		{
+			SlotPlayerStates[Slot] = PlayerState;
+			PlayerState->PlayerSlot = Slot;
+			PlayerState->OnCombatStatsChanged.Broadcast();
+			return true;
+		}
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("No free player slot for %s"), *PlayerState->GetPlayerName());
+	return false;
+}
+
+void AWSGameState::ReleasePlayerSlot(AWSPlayerState* PlayerState)
+{
+	if (!PlayerState || PlayerState->PlayerSlot == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (SlotPlayerStates[PlayerState->PlayerSlot] == PlayerState)
+	{
+		SlotPlayerStates[PlayerState->PlayerSlot] = nullptr;
+	}
+	PlayerState->PlayerSlot = INDEX_NONE;
+	PlayerState->OnCombatStatsChanged.Broadcast();
+}
+
+AWSPlayerState* AWSGameState::GetPlayerStateForSlot(int32 Slot) const
+{
+	if (Slot < 0 || Slot >= WSMaxPlayers)
+	{
+		return nullptr;
+	}
+
+	return SlotPlayerStates[Slot];
+}
+
+void AWSGameState::AwardKillCurrency(const FWSDamageLedger& DamageLedger, float MaxHealth, int32 CurrencyDropAmount)
+{
+	for (int32 Slot = 0; Slot < WSMaxPlayers; ++Slot)
+	{
+		const float Damage = DamageLedger.GetDamage(Slot);
+		if (Damage <= 0.0f)
+		{
+			continue;
+		}
+
+		AWSPlayerState* PS = GetPlayerStateForSlot(Slot);
+		if (PS)
+		{
+			// Distribute currency based on damage contribution
+			float DamagePercent = Damage / MaxHealth;
+			int32 CurrencyAmount = FMath::CeilToInt(CurrencyDropAmount * DamagePercent);
+			PS->AddCurrency(CurrencyAmount);
+		}
+	}
+}
+
 bool AWSGameState::IsGameOver() const
 {
 	return bGameOver;
@@ -0,0 +1,547 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSHitboxSubsystem.h"
+#include "WaveSurvival.h"
+#include "WSEnemyBase.h"
+#include "WSEnemyManagerSubsystem.h"
+#include "WSLagCompensationSubsystem.h"
+#include "WSSpatialGridSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hitbox Raycast"), STAT_WSHitboxRaycast, STATGROUP_WaveSurvival);
+
+namespace
+{
+	// Indexed by EWSHitRegion; reported in FHitResult::BoneName
+	const FName HitRegionNames[] = { TEXT("Body"), TEXT("Head"), TEXT("Limb") };
+}
+
+UWSHitboxSubsystem::UWSHitboxSubsystem()
+{
+	MaxHitboxReach = 150.0f;
+}
+
+bool UWSHitboxSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UWSHitboxSubsystem::RaycastHitboxes(const FVector& Start, const FVector& End, FHitResult& OutHit, double RewindTimestamp)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSHitboxRaycast);
+
+	const int32 NumHitboxes = RaycastCandidates(Start, End, RewindTimestamp);
+	const int32 BestIndex = FindNearestHitbox(NumHitboxes);
+	if (BestIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	MakeHit(BestIndex, Start, End, OutHit);
+	return true;
+}
+
+void UWSHitboxSubsystem::RaycastHitboxesBatch(const FVector& Start, TConstArrayView<FVector> Ends, TArrayView<FHitResult> OutHits, double RewindTimestamp)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSHitboxRaycast);
+	check(OutHits.Num() == Ends.Num());
+
+	for (FHitResult& Hit : OutHits)
+	{
+		Hit = FHitResult();
+	}
+
+	if (Ends.Num() == 0)
+	{
+		return;
+	}
+
+	// Every ray lies inside a cylinder around the spread axis, so one grid query finds all their candidates
+	FVector Direction;
+	float Length;
+	float Radius;
+	GetSpreadAxis(Start, Ends, Direction, Length, Radius);
+
+	const int32 NumHitboxes = PackCandidates(Start, Start + Direction * Length, Radius, RewindTimestamp);
+	if (NumHitboxes == 0)
+	{
+		return;
+	}
+
+	for (int32 Ray = 0; Ray < Ends.Num(); ++Ray)
+	{
+		RaycastPacked(Start, Ends[Ray], NumHitboxes);
+
+		const int32 BestIndex = FindNearestHitbox(NumHitboxes);
+		if (BestIndex != INDEX_NONE)
+		{
+			MakeHit(BestIndex, Start, Ends[Ray], OutHits[Ray]);
+		}
+	}
+}
+
+int32 UWSHitboxSubsystem::RaycastHitboxesMulti(const FVector& Start, const FVector& End, TArray<FHitResult>& OutHits, double RewindTimestamp)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSHitboxRaycast);
+
+	OutHits.Reset();
+	const int32 NumHitboxes = RaycastCandidates(Start, End, RewindTimestamp);
+
+	// Each enemy's hitboxes are packed together, so keep the nearest of every run
+	int32 RunStart = 0;
+	while (RunStart < NumHitboxes)
+	{
+		int32 BestIndex = INDEX_NONE;
+		float BestDistance = FLT_MAX;
+
+		int32 i = RunStart;
+		for (; i < NumHitboxes && HitboxOwners[i] == HitboxOwners[RunStart]; ++i)
+		{
+			if (Distances[i] < BestDistance)
+			{
+				BestDistance = Distances[i];
+				BestIndex = i;
+			}
+		}
+
+		if (BestIndex != INDEX_NONE)
+		{
+			MakeHit(BestIndex, Start, End, OutHits.AddDefaulted_GetRef());
+		}
+		RunStart = i;
+	}
+
+	OutHits.Sort([](const FHitResult& A, const FHitResult& B)
+	{
+		return A.Distance < B.Distance;
+	});
+
+	return OutHits.Num();
+}
+
+int32 UWSHitboxSubsystem::RaycastCandidates(const FVector& Start, const FVector& End, double RewindTimestamp)
+{
+	const int32 NumHitboxes = PackCandidates(Start, End, 0.0f, RewindTimestamp);
+	if (NumHitboxes > 0)
+	{
+		RaycastPacked(Start, End, NumHitboxes);
+	}
+	return NumHitboxes;
+}
+
+int32 UWSHitboxSubsystem::PackCandidates(const FVector& Start, const FVector& End, float ExtraRadius, double RewindTimestamp)
+{
+	const UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (!SpatialGrid || FVector::DistSquared(Start, End) <= FMath::Square(UE_KINDA_SMALL_NUMBER))
+	{
+		return 0;
+	}
+
+	// Rewound shots widen the query by the farthest an enemy can have moved since, then rewind only those candidates
+	const UWSLagCompensationSubsystem* LagCompensation = RewindTimestamp >= 0.0 ? GetWorld()->GetSubsystem<UWSLagCompensationSubsystem>() : nullptr;
+	UWSLagCompensationSubsystem::FRewindSample RewindSample;
+	const bool bRewind = LagCompensation && LagCompensation->FindRewindSample(RewindTimestamp, RewindSample);
+
+	const float QueryRadius = MaxHitboxReach + ExtraRadius + (bRewind ? RewindSample.MaxDisplacement : 0.0f);
+	if (SpatialGrid->QuerySegment(Start, End, QueryRadius, EWSSpatialCategory::Enemy, Candidates) == 0)
+	{
+		return 0;
+	}
+
+	CenterX.Reset();
+	CenterY.Reset();
+	CenterZ.Reset();
+	HalfHeights.Reset();
+	RadiiSq.Reset();
+	HitboxOwners.Reset();
+	HitboxRegions.Reset();
+
+	// Pack every candidate hitbox, with centres relative to the ray start to keep float precision in large maps
+	for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); ++CandidateIndex)
+	{
+		const AWSEnemyBase* Enemy = Cast<AWSEnemyBase>(Candidates[CandidateIndex]);
+		if (!Enemy || Enemy->IsPooled())
+		{
+			continue;
+		}
+
+		FVector Location = Enemy->GetActorLocation();
+		FQuat Rotation = Enemy->GetActorQuat();
+
+		float RewoundYaw;
+		if (bRewind && LagCompensation->GetRewoundTransform(RewindSample, Enemy->GetEnemyHandle(), Location, RewoundYaw))
+		{
+			Rotation = FRotator(0.0f, RewoundYaw, 0.0f).Quaternion();
+		}
+
+		for (const FWSHitbox& Hitbox : Enemy->Hitboxes)
+		{
+			const FVector Center = Location + Rotation.RotateVector(Hitbox.Offset) - Start;
+			CenterX.Add((float)Center.X);
+			CenterY.Add((float)Center.Y);
+			CenterZ.Add((float)Center.Z);
+			HalfHeights.Add(Hitbox.HalfHeight);
+			RadiiSq.Add(FMath::Square(Hitbox.Radius));
+			HitboxOwners.Add(CandidateIndex);
+			HitboxRegions.Add(Hitbox.Region);
+		}
+	}
+
+	const int32 NumHitboxes = HitboxOwners.Num();
+	if (NumHitboxes == 0)
+	{
+		return 0;
+	}
+
+	// Pad to whole lanes with hitboxes nothing can hit
+	const int32 PaddedCount = Align(NumHitboxes, 4);
+	for (int32 i = NumHitboxes; i < PaddedCount; ++i)
+	{
+		CenterX.Add(0.0f);
+		CenterY.Add(0.0f);
+		CenterZ.Add(0.0f);
+		HalfHeights.Add(0.0f);
+		RadiiSq.Add(-1.0f);
+	}
+	Distances.SetNumUninitialized(PaddedCount, EAllowShrinking::No);
+
+	return NumHitboxes;
+}
+
+void UWSHitboxSubsystem::RaycastPacked(const FVector& Start, const FVector& End, int32 NumHitboxes)
+{
+	const FVector Delta = End - Start;
+	const float Length = Delta.Size();
+	const int32 PaddedCount = Align(NumHitboxes, 4);
+
+	if (Length <= UE_KINDA_SMALL_NUMBER)
+	{
+		for (int32 i = 0; i < PaddedCount; ++i)
+		{
+			Distances[i] = FLT_MAX;
+		}
+		return;
+	}
+
+	RaycastCapsules(FVector3f(Delta / Length), Length, CenterX.GetData(), CenterY.GetData(), CenterZ.GetData(),
+		HalfHeights.GetData(), RadiiSq.GetData(), Distances.GetData(), PaddedCount);
+}
+
+int32 UWSHitboxSubsystem::FindNearestHitbox(int32 NumHitboxes) const
+{
+	int32 BestIndex = INDEX_NONE;
+	float BestDistance = FLT_MAX;
+	for (int32 i = 0; i < NumHitboxes; ++i)
+	{
+		if (Distances[i] < BestDistance)
+		{
+			BestDistance = Distances[i];
+			BestIndex = i;
+		}
+	}
+	return BestIndex;
+}
+
+void UWSHitboxSubsystem::GetSpreadAxis(const FVector& Start, TConstArrayView<FVector> Ends, FVector& OutDirection, float& OutLength, float& OutRadius)
+{
+	FVector Sum = FVector::ZeroVector;
+	for (const FVector& End : Ends)
+	{
+		Sum += (End - Start).GetSafeNormal();
+	}
+	OutDirection = Sum.GetSafeNormal();
+	OutLength = 0.0f;
+	OutRadius = 0.0f;
+
+	// Rays diverge from Start, so each is farthest from the axis at its end
+	for (const FVector& End : Ends)
+	{
+		const FVector Offset = End - Start;
+		const float Along = (float)FVector::DotProduct(Offset, OutDirection);
+		OutLength = FMath::Max(OutLength, Along);
+		OutRadius = FMath::Max(OutRadius, (float)(Offset - OutDirection * Along).Size());
+	}
+}
+
+
+void UWSHitboxSubsystem::MakeHit(int32 HitboxIndex, const FVector& Start, const FVector& End, FHitResult& OutHit) const
+{
+	const FVector Direction = (End - Start).GetSafeNormal();
+	const float Distance = Distances[HitboxIndex];
+
+	OutHit = FHitResult(Candidates[HitboxOwners[HitboxIndex]], nullptr, Start + Direction * Distance, -Direction);
+	OutHit.bBlockingHit = true;
+	OutHit.Distance = Distance;
+	OutHit.Time = Distance / FVector::Dist(Start, End);
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = End;
+	OutHit.BoneName = HitRegionNames[(int32)HitboxRegions[HitboxIndex]];
+}
+
+bool UWSHitboxSubsystem::TraceHitscan(const FVector& Start, const FVector& End, const FCollisionQueryParams& QueryParams, FHitResult& OutHit, double RewindTimestamp)
+{
+	FHitResult WorldHit;
+	const bool bHitWorld = GetWorld()->LineTraceSingleByObjectType(WorldHit, Start, End, GetOcclusionObjectParams(), QueryParams);
+
+	// Nothing past the occluder can be hit, so stop the ray there
+	FHitResult EnemyHit;
+	const bool bHitEnemy = RaycastHitboxes(Start, bHitWorld ? WorldHit.Location : End, EnemyHit, RewindTimestamp);
+
+	return SelectHit(bHitEnemy, EnemyHit, bHitWorld, WorldHit, OutHit);
+}
+
+void UWSHitboxSubsystem::TraceHitscanBatch(const FVector& Start, TConstArrayView<FVector> Ends, const FCollisionQueryParams& QueryParams, TArrayView<FHitResult> OutHits, double RewindTimestamp)
+{
+	RaycastHitboxesBatch(Start, Ends, OutHits, RewindTimestamp);
+
+	FVector Center;
+	FQuat Rotation;
+	const FCollisionShape Bounds = GetSpreadBounds(Start, Ends, Center, Rotation);
+
+	TArray<FOverlapResult> Occluders;
+	GetWorld()->OverlapMultiByObjectType(Occluders, Center, Rotation, GetOcclusionObjectParams(), Bounds, QueryParams);
+
+	for (int32 Ray = 0; Ray < Ends.Num(); ++Ray)
+	{
+		FHitResult WorldHit;
+		const bool bHitWorld = TraceOccluders(Occluders, Start, Ends[Ray], WorldHit);
+		const FHitResult EnemyHit = OutHits[Ray];
+
+		if (!SelectHit(EnemyHit.bBlockingHit, EnemyHit, bHitWorld, WorldHit, OutHits[Ray]))
+		{
+			OutHits[Ray] = FHitResult();
+		}
+	}
+}
+
+int32 UWSHitboxSubsystem::TraceHitscanMulti(const FVector& Start, const FVector& End, const FCollisionQueryParams& QueryParams, TArray<FHitResult>& OutEnemyHits, FHitResult& OutWorldHit, double RewindTimestamp)
+{
+	const bool bHitWorld = GetWorld()->LineTraceSingleByObjectType(OutWorldHit, Start, End, GetOcclusionObjectParams(), QueryParams);
+	if (!bHitWorld)
+	{
+		OutWorldHit = FHitResult();
+	}
+
+	return RaycastHitboxesMulti(Start, bHitWorld ? OutWorldHit.Location : End, OutEnemyHits, RewindTimestamp);
+}
+
+bool UWSHitboxSubsystem::SelectHit(bool bHitEnemy, const FHitResult& EnemyHit, bool bHitWorld, const FHitResult& WorldHit, FHitResult& OutHit)
+{
+	if (bHitEnemy && (!bHitWorld || EnemyHit.Distance <= WorldHit.Distance))
+	{
+		OutHit = EnemyHit;
+		return true;
+	}
+
+	if (bHitWorld)
+	{
+		OutHit = WorldHit;
+		return true;
+	}
+
+	return false;
+}
+
+FCollisionObjectQueryParams UWSHitboxSubsystem::GetOcclusionObjectParams()
+{
+	FCollisionObjectQueryParams ObjectParams;
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+	return ObjectParams;
+}
+
+FCollisionShape UWSHitboxSubsystem::GetSpreadBounds(const FVector& Start, TConstArrayView<FVector> Ends, FVector& OutCenter, FQuat& OutRotation)
+{
+	FVector Direction;
+	float Length;
+	float Radius;
+	GetSpreadAxis(Start, Ends, Direction, Length, Radius);
+
+	// Box along the spread axis, padded so rays grazing its sides still see what they touch
+	constexpr float Padding = 1.0f;
+	OutRotation = FRotationMatrix::MakeFromX(Direction).ToQuat();
+	OutCenter = Start + Direction * (Length * 0.5f);
+	return FCollisionShape::MakeBox(FVector(Length * 0.5f + Padding, Radius + Padding, Radius + Padding));
+}
+
+bool UWSHitboxSubsystem::TraceOccluders(TConstArrayView<FOverlapResult> Occluders, const FVector& Start, const FVector& End, FHitResult& OutHit)
+{
+	// Narrow phase only: the overlap already did the broad phase for every ray
+	const FCollisionQueryParams ComponentParams(SCENE_QUERY_STAT(WSOccluderTrace));
+
+	bool bHit = false;
+	for (const FOverlapResult& Occluder : Occluders)
+	{
+		UPrimitiveComponent* Component = Occluder.GetComponent();
+		FHitResult Hit;
+		if (!Component || !Component->LineTraceComponent(Hit, Start, End, ComponentParams))
+		{
+			continue;
+		}
+
+		Hit.bBlockingHit = true;
+		Hit.Distance = FVector::Dist(Start, Hit.Location);
+		if (!bHit || Hit.Distance < OutHit.Distance)
+		{
+			OutHit = Hit;
+			bHit = true;
+		}
+	}
+
+	return bHit;
+}
+
+EWSHitRegion UWSHitboxSubsystem::GetHitRegion(const FHitResult& Hit)
+{
+	for (int32 Region = 0; Region < UE_ARRAY_COUNT(HitRegionNames); ++Region)
+	{
+		if (Hit.BoneName == HitRegionNames[Region])
+		{
+			return (EWSHitRegion)Region;
+		}
+	}
+	return EWSHitRegion::Body;
+}
+
+void UWSHitboxSubsystem::RaycastCapsules(const FVector3f& Direction, float Length, const float* InCenterX, const float* InCenterY, const float* InCenterZ,
+	const float* InHalfHeights, const float* InRadiiSq, float* OutDistances, int32 Count)
+{
+	check(Count % 4 == 0);
+
+	// Closest points between the ray and each capsule axis, with W = RayStart - Centre and the axis along Z:
+	// S = clamp((B*E - D) / (1 - B^2), 0, Length), T = clamp(B*S + E, -HalfHeight, HalfHeight), then S re-clamped against T
+	const float AxisDot = Direction.Z;
+	const float Denom = 1.0f - AxisDot * AxisDot;
+	const float InvDenom = Denom > UE_KINDA_SMALL_NUMBER ? 1.0f / Denom : 0.0f;
+
+	const VectorRegister4Float DirX = VectorSetFloat1(Direction.X);
+	const VectorRegister4Float DirY = VectorSetFloat1(Direction.Y);
+	const VectorRegister4Float DirZ = VectorSetFloat1(Direction.Z);
+	const VectorRegister4Float B = VectorSetFloat1(AxisDot);
+	const VectorRegister4Float InvDen = VectorSetFloat1(InvDenom);
+	const VectorRegister4Float MaxS = VectorSetFloat1(Length);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float Miss = VectorSetFloat1(FLT_MAX);
+
+	for (int32 i = 0; i < Count; i += 4)
+	{
+		const VectorRegister4Float WX = VectorNegate(VectorLoad(InCenterX + i));
+		const VectorRegister4Float WY = VectorNegate(VectorLoad(InCenterY + i));
+		const VectorRegister4Float WZ = VectorNegate(VectorLoad(InCenterZ + i));
+		const VectorRegister4Float HalfHeight = VectorLoad(InHalfHeights + i);
+		const VectorRegister4Float RadiusSq = VectorLoad(InRadiiSq + i);
+
+		const VectorRegister4Float D = VectorMultiplyAdd(DirX, WX, VectorMultiplyAdd(DirY, WY, VectorMultiply(DirZ, WZ)));
+
+		VectorRegister4Float S = VectorMultiply(VectorSubtract(VectorMultiply(B, WZ), D), InvDen);
+		S = VectorMin(VectorMax(S, Zero), MaxS);
+
+		const VectorRegister4Float T = VectorMin(VectorMax(VectorMultiplyAdd(B, S, WZ), VectorNegate(HalfHeight)), HalfHeight);
+		S = VectorMin(VectorMax(VectorSubtract(VectorMultiply(B, T), D), Zero), MaxS);
+
+		// Offset from the axis point to the ray point
+		const VectorRegister4Float PX = VectorMultiplyAdd(DirX, S, WX);
+		const VectorRegister4Float PY = VectorMultiplyAdd(DirY, S, WY);
+		const VectorRegister4Float PZ = VectorSubtract(VectorMultiplyAdd(DirZ, S, WZ), T);
+		const VectorRegister4Float DistSq = VectorMultiplyAdd(PX, PX, VectorMultiplyAdd(PY, PY, VectorMultiply(PZ, PZ)));
+
+		// Back off to where the ray enters the surface; exact for spheres, slightly deep on capsule sides
+		const VectorRegister4Float Penetration = VectorSqrt(VectorMax(VectorSubtract(RadiusSq, DistSq), Zero));
+		const VectorRegister4Float Entry = VectorMax(VectorSubtract(S, Penetration), Zero);
+
+		VectorStore(VectorSelect(VectorCompareLE(DistSq, RadiusSq), Entry, Miss), OutDistances + i);
+	}
+}
+
+void UWSHitboxSubsystem::RunBenchmark(int32 NumRays, float Range, float RewindSeconds)
+{
+	const UWSEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UWSEnemyManagerSubsystem>();
+	const int32 NumEnemies = EnemyManager ? EnemyManager->GetTotalEnemyCount() : 0;
+	if (NumEnemies == 0 || NumRays <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Hitbox benchmark: no enemies registered"));
+		return;
+	}
+
+	// Fire from the local player's view when there is one
+	FVector Origin = FVector::ZeroVector;
+	if (const APlayerController* PC = GetWorld()->GetFirstPlayerController())
+	{
+		FRotator Unused;
+		PC->GetPlayerViewPoint(Origin, Unused);
+	}
+
+	// Same rays for both methods, mostly level like real shots
+	TArray<FVector> Ends;
+	for (int32 Ray = 0; Ray < NumRays; ++Ray)
+	{
+		FVector Direction = FMath::VRand();
+		Direction.Z *= 0.2f;
+		Ends.Add(Origin + Direction.GetSafeNormal() * Range);
+	}
+
+	FHitResult Hit;
+	int32 HitboxHits = 0;
+	const double HitboxStart = FPlatformTime::Seconds();
+	for (const FVector& End : Ends)
+	{
+		HitboxHits += RaycastHitboxes(Origin, End, Hit) ? 1 : 0;
+	}
+	const double HitboxSeconds = FPlatformTime::Seconds() - HitboxStart;
+
+	// Reference: the physics trace weapons used before hitboxes, which also sees enemy capsules
+	int32 PhysicsHits = 0;
+	const double PhysicsStart = FPlatformTime::Seconds();
+	for (const FVector& End : Ends)
+	{
+		PhysicsHits += GetWorld()->LineTraceSingleByChannel(Hit, Origin, End, ECC_Visibility) ? 1 : 0;
+	}
+	const double PhysicsSeconds = FPlatformTime::Seconds() - PhysicsStart;
+
+	UE_LOG(LogTemp, Log, TEXT("Hitbox benchmark (%d enemies, %d rays, %.0f range): hitboxes %.2f us/ray (%d hits), physics trace %.2f us/ray (%d hits)"),
+		NumEnemies, NumRays, Range,
+		HitboxSeconds * 1.0e6 / NumRays, HitboxHits,
+		PhysicsSeconds * 1.0e6 / NumRays, PhysicsHits);
+
+	// Lag-compensated rays against the recorded history
+	const UWSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UWSLagCompensationSubsystem>();
+	if (!LagCompensation || RewindSeconds <= 0.0f)
+	{
+		return;
+	}
+
+	const double RewindTimestamp = GetWorld()->GetTimeSeconds() - RewindSeconds;
+	int32 RewoundHits = 0;
+	const double RewoundStart = FPlatformTime::Seconds();
+	for (const FVector& End : Ends)
+	{
+		RewoundHits += RaycastHitboxes(Origin, End, Hit, RewindTimestamp) ? 1 : 0;
+	}
+	const double RewoundSeconds = FPlatformTime::Seconds() - RewoundStart;
+
+	UE_LOG(LogTemp, Log, TEXT("Hitbox benchmark rewound %.0f ms: %.2f us/ray (%d hits); history %.1f KB, recorded in %.3f ms/frame"),
+		RewindSeconds * 1000.0f,
+		RewoundSeconds * 1.0e6 / NumRays, RewoundHits,
+		LagCompensation->GetHistoryMemoryBytes() / 1024.0f, LagCompensation->GetLastRecordMilliseconds());
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs GWSHitboxBenchmarkCommand(
+	TEXT("ws.Hitbox.Benchmark"),
+	TEXT("Times random rays from the player's view against enemy hitboxes and against a physics trace. With RewindMs, also times lag-compensated rays and reports history memory. Run at different horde sizes to compare. Usage: ws.Hitbox.Benchmark [Rays=2000] [Range=5000] [RewindMs=0]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UWSHitboxSubsystem* Hitboxes = World ? World->GetSubsystem<UWSHitboxSubsystem>() : nullptr;
+		if (Hitboxes)
+		{
+			const int32 NumRays = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 2000;
+			const float Range = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 5000.0f;
+			const float RewindSeconds = Args.Num() > 2 ? FCString::Atof(*Args[2]) / 1000.0f : 0.0f;
+			Hitboxes->RunBenchmark(NumRays, Range, RewindSeconds);
+		}
+	}));
+#endif
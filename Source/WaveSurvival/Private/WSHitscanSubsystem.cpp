@@ -0,0 +1,196 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSHitscanSubsystem.h"
+#include "WaveSurvival.h"
+#include "WSWeaponBase.h"
+#include "WSHitboxSubsystem.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hitscan Resolve"), STAT_WSHitscanResolve, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Shots Resolved"), STAT_WSHitscanShotsResolved, STATGROUP_WaveSurvival);
+
+bool UWSHitscanSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWSHitscanSubsystem::Deinitialize()
+{
+	PendingShots.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWSHitscanSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSHitscanResolve);
+
+	// Async traces run at the end of the frame they were requested in, so only
+	// shots from earlier frames are ready. Resolve them in firing order.
+	int32 NumResolved = 0;
+	while (NumResolved < PendingShots.Num() && PendingShots[NumResolved].SubmitFrame < GFrameCounter)
+	{
+		ResolveShot(PendingShots[NumResolved]);
+		NumResolved++;
+	}
+
+	if (NumResolved > 0)
+	{
+		PendingShots.RemoveAt(0, NumResolved, EAllowShrinking::No);
+	}
+
+	SET_DWORD_STAT(STAT_WSHitscanShotsResolved, NumResolved);
+}
+
+TStatId UWSHitscanSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWSHitscanSubsystem, STATGROUP_Tickables);
+}
+
+void UWSHitscanSubsystem::QueueShot(AWSWeaponBase* Weapon, const FVector& TraceStart, const FVector& TraceEnd)
+{
+	if (!Weapon)
+	{
+		return;
+	}
+
+	FPendingShot& Shot = PendingShots.AddDefaulted_GetRef();
+	Shot.Weapon = Weapon;
+	Shot.TraceStart = TraceStart;
+	QueueTrace(Shot, TraceEnd, Weapon->GetHitscanQueryParams(), Weapon->GetShotTimestamp());
+	Shot.SubmitFrame = GFrameCounter;
+	Shot.bIsPelletBatch = false;
+}
+
+void UWSHitscanSubsystem::QueueShotBatch(AWSWeaponBase* Weapon, const FVector& TraceStart, const TArray<FVector>& TraceEnds)
+{
+	if (!Weapon || TraceEnds.Num() == 0)
+	{
+		return;
+	}
+
+	FPendingShot& Shot = PendingShots.AddDefaulted_GetRef();
+	Shot.Weapon = Weapon;
+	Shot.TraceStart = TraceStart;
+	Shot.TraceEnds = TraceEnds;
+
+	FVector Center;
+	FQuat Rotation;
+	const FCollisionShape Bounds = UWSHitboxSubsystem::GetSpreadBounds(TraceStart, TraceEnds, Center, Rotation);
+	Shot.OverlapHandle = GetWorld()->AsyncOverlapByObjectType(Center, Rotation,
+		UWSHitboxSubsystem::GetOcclusionObjectParams(), Bounds, Weapon->GetHitscanQueryParams());
+
+	Shot.EnemyHits.SetNum(TraceEnds.Num());
+	if (UWSHitboxSubsystem* HitboxSubsystem = GetWorld()->GetSubsystem<UWSHitboxSubsystem>())
+	{
+		HitboxSubsystem->RaycastHitboxesBatch(TraceStart, TraceEnds, Shot.EnemyHits, Weapon->GetShotTimestamp());
+	}
+	Shot.SubmitFrame = GFrameCounter;
+	Shot.bIsPelletBatch = true;
+}
+
+void UWSHitscanSubsystem::QueueTrace(FPendingShot& Shot, const FVector& TraceEnd, const FCollisionQueryParams& QueryParams, double RewindTimestamp)
+{
+	Shot.TraceEnds.Add(TraceEnd);
+	Shot.TraceHandles.Add(GetWorld()->AsyncLineTraceByObjectType(
+		EAsyncTraceType::Single,
+		Shot.TraceStart,
+		TraceEnd,
+		UWSHitboxSubsystem::GetOcclusionObjectParams(),
+		QueryParams
+	));
+
+	// Enemies are tested where they stand when the shot is fired, not where they are when it resolves
+	FHitResult& EnemyHit = Shot.EnemyHits.AddDefaulted_GetRef();
+	if (UWSHitboxSubsystem* HitboxSubsystem = GetWorld()->GetSubsystem<UWSHitboxSubsystem>())
+	{
+		HitboxSubsystem->RaycastHitboxes(Shot.TraceStart, TraceEnd, EnemyHit, RewindTimestamp);
+	}
+}
+
+int32 UWSHitscanSubsystem::GetPendingShotCount() const
+{
+	return PendingShots.Num();
+}
+
+void UWSHitscanSubsystem::ResolveShot(const FPendingShot& Shot)
+{
+	AWSWeaponBase* Weapon = Shot.Weapon.Get();
+	if (!Weapon)
+	{
+		return;
+	}
+
+	if (!Shot.bIsPelletBatch)
+	{
+		FHitResult HitResult;
+		const bool bHit = GetTraceResult(Shot, 0, HitResult);
+		Weapon->ApplyHitscanResult(bHit, HitResult, Shot.TraceStart, Shot.TraceEnds[0]);
+		return;
+	}
+
+	TArray<FOverlapResult> Occluders;
+	GetPelletOccluders(Shot, Occluders);
+
+	TArray<FHitResult> PelletHits;
+	for (int32 TraceIndex = 0; TraceIndex < Shot.TraceEnds.Num(); ++TraceIndex)
+	{
+		FHitResult WorldHit;
+		const bool bHitWorld = UWSHitboxSubsystem::TraceOccluders(Occluders, Shot.TraceStart, Shot.TraceEnds[TraceIndex], WorldHit);
+
+		const FHitResult& EnemyHit = Shot.EnemyHits[TraceIndex];
+		FHitResult HitResult;
+		if (UWSHitboxSubsystem::SelectHit(EnemyHit.bBlockingHit, EnemyHit, bHitWorld, WorldHit, HitResult))
+		{
+			PelletHits.Add(HitResult);
+		}
+	}
+
+	Weapon->ApplyPelletResults(PelletHits, Shot.TraceStart);
+}
+
+void UWSHitscanSubsystem::GetPelletOccluders(const FPendingShot& Shot, TArray<FOverlapResult>& OutOccluders) const
+{
+	FOverlapDatum OverlapData;
+	if (GetWorld()->QueryOverlapData(Shot.OverlapHandle, OverlapData))
+	{
+		OutOccluders = MoveTemp(OverlapData.OutOverlaps);
+		return;
+	}
+
+	// The async result expired (e.g. after a hitch); overlap now rather than drop the shot
+	if (const AWSWeaponBase* Weapon = Shot.Weapon.Get())
+	{
+		FVector Center;
+		FQuat Rotation;
+		const FCollisionShape Bounds = UWSHitboxSubsystem::GetSpreadBounds(Shot.TraceStart, Shot.TraceEnds, Center, Rotation);
+		GetWorld()->OverlapMultiByObjectType(OutOccluders, Center, Rotation,
+			UWSHitboxSubsystem::GetOcclusionObjectParams(), Bounds, Weapon->GetHitscanQueryParams());
+	}
+}
+
+bool UWSHitscanSubsystem::GetTraceResult(const FPendingShot& Shot, int32 TraceIndex, FHitResult& OutHit) const
+{
+	const FHitResult& EnemyHit = Shot.EnemyHits[TraceIndex];
+
+	FHitResult WorldHit;
+	bool bHitWorld = false;
+
+	FTraceDatum TraceData;
+	if (GetWorld()->QueryTraceData(Shot.TraceHandles[TraceIndex], TraceData))
+	{
+		if (TraceData.OutHits.Num() > 0 && TraceData.OutHits[0].bBlockingHit)
+		{
+			WorldHit = TraceData.OutHits[0];
+			bHitWorld = true;
+		}
+	}
+	else if (AWSWeaponBase* Weapon = Shot.Weapon.Get())
+	{
+		// The async result expired (e.g. after a hitch); trace now rather than drop the shot
+		bHitWorld = GetWorld()->LineTraceSingleByObjectType(WorldHit, Shot.TraceStart, Shot.TraceEnds[TraceIndex],
+			UWSHitboxSubsystem::GetOcclusionObjectParams(), Weapon->GetHitscanQueryParams());
+	}
+
+	return UWSHitboxSubsystem::SelectHit(EnemyHit.bBlockingHit, EnemyHit, bHitWorld, WorldHit, OutHit);
+}
@@ -0,0 +1,216 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSLagCompensationSubsystem.h"
+#include "WaveSurvival.h"
+#include "WSEnemyBase.h"
+#include "WSEnemyManagerSubsystem.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lag Compensation Record"), STAT_WSLagCompensationRecord, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lag Compensation Memory (KB)"), STAT_WSLagCompensationMemory, STATGROUP_WaveSurvival);
+
+UWSLagCompensationSubsystem::UWSLagCompensationSubsystem()
+{
+	// 0.4s of history at 60Hz, 25 frames
+	RecordInterval = 1.0f / 60.0f;
+	MaxRewindTime = 0.4f;
+	MaxEnemySpeed = 1500.0f;
+
+	NewestFrame = INDEX_NONE;
+	LastRecordTime = -1.0;
+	bRecording = false;
+	LastRecordMilliseconds = 0.0f;
+}
+
+bool UWSLagCompensationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWSLagCompensationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Only the authority validates shots
+	bRecording = InWorld.GetNetMode() != NM_Client;
+
+	// Frames are at least RecordInterval apart, so this many span MaxRewindTime, plus one to interpolate from
+	const int32 HistoryLength = FMath::CeilToInt(MaxRewindTime / FMath::Max(RecordInterval, UE_KINDA_SMALL_NUMBER)) + 1;
+	Frames.SetNum(bRecording ? FMath::Max(HistoryLength, 2) : 0);
+}
+
+void UWSLagCompensationSubsystem::Deinitialize()
+{
+	Frames.Empty();
+	NewestFrame = INDEX_NONE;
+	LastRecordTime = -1.0;
+
+	Super::Deinitialize();
+}
+
+void UWSLagCompensationSubsystem::Tick(float DeltaTime)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	// Fixed spacing keeps the ring covering MaxRewindTime at any tick rate
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (LastRecordTime < 0.0 || Now - LastRecordTime >= RecordInterval)
+	{
+		RecordFrame();
+		LastRecordTime = Now;
+	}
+
+	SET_DWORD_STAT(STAT_WSLagCompensationMemory, GetHistoryMemoryBytes() / 1024);
+}
+
+TStatId UWSLagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWSLagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+double UWSLagCompensationSubsystem::ClampRewindTimestamp(double Timestamp) const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	return FMath::Clamp(Timestamp, Now - MaxRewindTime, Now);
+}
+
+bool UWSLagCompensationSubsystem::FindRewindSample(double Timestamp, FRewindSample& OutSample) const
+{
+	if (NewestFrame == INDEX_NONE)
+	{
+		return false;
+	}
+
+	Timestamp = ClampRewindTimestamp(Timestamp);
+	const double Now = GetWorld()->GetTimeSeconds();
+	OutSample.MaxDisplacement = (float)(Now - Timestamp) * MaxEnemySpeed;
+
+	// Walk back from the newest frame to the first one at or before Timestamp
+	int32 Newer = NewestFrame;
+	for (int32 Step = 0; Step < Frames.Num(); ++Step)
+	{
+		const int32 Frame = (NewestFrame - Step + Frames.Num()) % Frames.Num();
+		const double FrameTime = Frames[Frame].Timestamp;
+		if (FrameTime < 0.0)
+		{
+			break;
+		}
+
+		if (FrameTime <= Timestamp)
+		{
+			// Newer than anything recorded; where enemies stand now is closer than the last frame
+			if (Step == 0)
+			{
+				return false;
+			}
+
+			const double Span = Frames[Newer].Timestamp - FrameTime;
+			OutSample.OlderFrame = Frame;
+			OutSample.NewerFrame = Newer;
+			OutSample.Alpha = Span > UE_SMALL_NUMBER ? (float)((Timestamp - FrameTime) / Span) : 0.0f;
+			return true;
+		}
+
+		Newer = Frame;
+	}
+
+	// Older than the history; use the oldest frame recorded
+	OutSample.OlderFrame = Newer;
+	OutSample.NewerFrame = Newer;
+	OutSample.Alpha = 0.0f;
+	return true;
+}
+
+bool UWSLagCompensationSubsystem::GetRewoundTransform(const FRewindSample& Sample, const FWSEnemyHandle& Handle, FVector& OutLocation, float& OutYaw) const
+{
+	if (Sample.OlderFrame == INDEX_NONE || !Handle.IsSet())
+	{
+		return false;
+	}
+
+	const FHistoryFrame& Older = Frames[Sample.OlderFrame];
+	const FHistoryFrame& Newer = Frames[Sample.NewerFrame];
+	const int32 Slot = Handle.Index;
+
+	const bool bInOlder = Older.Generations.IsValidIndex(Slot) && Older.Generations[Slot] == Handle.Generation;
+	const bool bInNewer = Newer.Generations.IsValidIndex(Slot) && Newer.Generations[Slot] == Handle.Generation;
+	if (!bInOlder && !bInNewer)
+	{
+		return false;
+	}
+
+	// Spawned between the two frames: hold the frame it exists in
+	const FHistoryFrame& From = bInOlder ? Older : Newer;
+	const FHistoryFrame& To = bInNewer ? Newer : Older;
+	const float Alpha = Sample.Alpha;
+
+	OutLocation = FVector(
+		FMath::Lerp(From.X[Slot], To.X[Slot], Alpha),
+		FMath::Lerp(From.Y[Slot], To.Y[Slot], Alpha),
+		FMath::Lerp(From.Z[Slot], To.Z[Slot], Alpha));
+	OutYaw = From.Yaw[Slot] + FMath::FindDeltaAngleDegrees(From.Yaw[Slot], To.Yaw[Slot]) * Alpha;
+	return true;
+}
+
+int32 UWSLagCompensationSubsystem::GetHistoryMemoryBytes() const
+{
+	int32 Bytes = 0;
+	for (const FHistoryFrame& Frame : Frames)
+	{
+		Bytes += Frame.X.GetAllocatedSize() + Frame.Y.GetAllocatedSize() + Frame.Z.GetAllocatedSize()
+			+ Frame.Yaw.GetAllocatedSize() + Frame.Generations.GetAllocatedSize();
+	}
+	return Bytes;
+}
+
+float UWSLagCompensationSubsystem::GetLastRecordMilliseconds() const
+{
+	return LastRecordMilliseconds;
+}
+
+void UWSLagCompensationSubsystem::RecordFrame()
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSLagCompensationRecord);
+	const double StartTime = FPlatformTime::Seconds();
+
+	const UWSEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UWSEnemyManagerSubsystem>();
+	if (!EnemyManager || Frames.Num() == 0)
+	{
+		return;
+	}
+
+	NewestFrame = (NewestFrame + 1) % Frames.Num();
+	FHistoryFrame& Frame = Frames[NewestFrame];
+	Frame.Timestamp = GetWorld()->GetTimeSeconds();
+
+	// Slots only grow, so each frame's arrays settle at the peak enemy count
+	const int32 NumSlots = EnemyManager->GetSlotCount();
+	Frame.X.SetNumUninitialized(NumSlots, EAllowShrinking::No);
+	Frame.Y.SetNumUninitialized(NumSlots, EAllowShrinking::No);
+	Frame.Z.SetNumUninitialized(NumSlots, EAllowShrinking::No);
+	Frame.Yaw.SetNumUninitialized(NumSlots, EAllowShrinking::No);
+	Frame.Generations.SetNumUninitialized(NumSlots, EAllowShrinking::No);
+	FMemory::Memset(Frame.Generations.GetData(), 0xFF, NumSlots * sizeof(int32));
+
+	for (int32 TypeIndex = 0; TypeIndex < UWSEnemyManagerSubsystem::NumEnemyTypes; ++TypeIndex)
+	{
+		const FWSEnemyBatch& Batch = EnemyManager->GetBatch((EWSEnemyType)TypeIndex);
+		for (int32 i = 0; i < Batch.Num(); ++i)
+		{
+			const AWSEnemyBase* Enemy = Batch.Enemies[i];
+			const int32 Slot = Batch.SlotIndices[i];
+			const FVector Location = Enemy->GetActorLocation();
+
+			Frame.X[Slot] = (float)Location.X;
+			Frame.Y[Slot] = (float)Location.Y;
+			Frame.Z[Slot] = (float)Location.Z;
+			Frame.Yaw[Slot] = (float)Enemy->GetActorRotation().Yaw;
+			Frame.Generations[Slot] = Enemy->GetEnemyHandle().Generation;
+		}
+	}
+
+	LastRecordMilliseconds = (float)((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSMassEnemyProcessors.h"
+#include "WSMassEnemyFragments.h"
+#include "WSMassEnemySubsystem.h"
+#include "WSFlowFieldSubsystem.h"
+#include "MassExecutionContext.h"
+
+UWSMassEnemyTargetingProcessor::UWSMassEnemyTargetingProcessor()
+	: EntityQuery(*this)
+{
+	bAutoRegisterWithProcessingPhases = false;
+	bRequiresGameThreadExecution = true;
+}
+
+void UWSMassEnemyTargetingProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FWSMassLocationFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FWSMassTargetFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void UWSMassEnemyTargetingProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	UWSMassEnemySubsystem* EnemySubsystem = GetTypedOuter<UWSMassEnemySubsystem>();
+	if (!EnemySubsystem || EnemySubsystem->GetPlayerViews().Num() == 0)
+	{
+		return;
+	}
+
+	const TArray<UWSMassEnemySubsystem::FPlayerView>& PlayerViews = EnemySubsystem->GetPlayerViews();
+	const float RetargetInterval = EnemySubsystem->GetRetargetInterval();
+
+	EntityQuery.ForEachEntityChunk(Context, [EnemySubsystem, &PlayerViews, RetargetInterval](FMassExecutionContext& Context)
+	{
+		const TConstArrayView<FWSMassLocationFragment> Locations = Context.GetFragmentView<FWSMassLocationFragment>();
+		const TArrayView<FWSMassTargetFragment> Targets = Context.GetMutableFragmentView<FWSMassTargetFragment>();
+		const float DeltaTime = Context.GetDeltaTimeSeconds();
+
+		for (int32 i = 0; i < Context.GetNumEntities(); ++i)
+		{
+			FWSMassTargetFragment& Target = Targets[i];
+			Target.RetargetTimer -= DeltaTime;
+			if (Target.RetargetTimer > 0.0f)
+			{
+				continue;
+			}
+			Target.RetargetTimer += RetargetInterval;
+
+			const FVector& Location = Locations[i].Location;
+
+			// Regular enemies target the nearest player
+			float NearestDistSq = FLT_MAX;
+			for (const UWSMassEnemySubsystem::FPlayerView& View : PlayerViews)
+			{
+				const float DistSq = FVector::DistSquared(Location, View.Location);
+				if (DistSq < NearestDistSq)
+				{
+					NearestDistSq = DistSq;
+					Target.TargetLocation = View.Location;
+				}
+			}
+			Target.bHasTarget = true;
+
+			float Priority;
+			if (EnemySubsystem->ShouldPromote(Location, NearestDistSq, Priority))
+			{
+				EnemySubsystem->RequestPromotion(Context.GetEntity(i), Priority);
+			}
+		}
+	});
+}
+
+UWSMassEnemyMovementProcessor::UWSMassEnemyMovementProcessor()
+	: EntityQuery(*this)
+{
+	bAutoRegisterWithProcessingPhases = false;
+	bRequiresGameThreadExecution = true;
+}
+
+void UWSMassEnemyMovementProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FWSMassEnemyFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FWSMassTargetFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FWSMassLocationFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void UWSMassEnemyMovementProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	const UWSFlowFieldSubsystem* FlowField = GetWorld() ? GetWorld()->GetSubsystem<UWSFlowFieldSubsystem>() : nullptr;
+
+	EntityQuery.ForEachEntityChunk(Context, [FlowField](FMassExecutionContext& Context)
+	{
+		const TConstArrayView<FWSMassEnemyFragment> Enemies = Context.GetFragmentView<FWSMassEnemyFragment>();
+		const TConstArrayView<FWSMassTargetFragment> Targets = Context.GetFragmentView<FWSMassTargetFragment>();
+		const TArrayView<FWSMassLocationFragment> Locations = Context.GetMutableFragmentView<FWSMassLocationFragment>();
+		const float DeltaTime = Context.GetDeltaTimeSeconds();
+
+		for (int32 i = 0; i < Context.GetNumEntities(); ++i)
+		{
+			const FWSMassTargetFragment& Target = Targets[i];
+			if (!Target.bHasTarget)
+			{
+				continue;
+			}
+
+			FWSMassLocationFragment& Location = Locations[i];
+			const FVector ToTarget = Target.TargetLocation - Location.Location;
+			if (ToTarget.SizeSquared2D() <= FMath::Square(Enemies[i].AttackRange))
+			{
+				continue;
+			}
+
+			FVector Direction = FlowField ? FlowField->GetFlowDirection(Location.Location) : FVector::ZeroVector;
+			if (Direction.IsZero())
+			{
+				Direction = ToTarget.GetSafeNormal2D();
+			}
+
+			// Entities keep their spawn height; collision is only resolved once promoted to an actor
+			Location.Location += Direction * Enemies[i].MovementSpeed * DeltaTime;
+			Location.Facing = Direction;
+		}
+	});
+}
+
+UWSMassEnemyVisualizationProcessor::UWSMassEnemyVisualizationProcessor()
+	: EntityQuery(*this)
+{
+	bAutoRegisterWithProcessingPhases = false;
+	bRequiresGameThreadExecution = true;
+}
+
+void UWSMassEnemyVisualizationProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FWSMassEnemyFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FWSMassLocationFragment>(EMassFragmentAccess::ReadOnly);
+}
+
+void UWSMassEnemyVisualizationProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	UWSMassEnemySubsystem* EnemySubsystem = GetTypedOuter<UWSMassEnemySubsystem>();
+	if (!EnemySubsystem)
+	{
+		return;
+	}
+
+	EntityQuery.ForEachEntityChunk(Context, [EnemySubsystem](FMassExecutionContext& Context)
+	{
+		const TConstArrayView<FWSMassEnemyFragment> Enemies = Context.GetFragmentView<FWSMassEnemyFragment>();
+		const TConstArrayView<FWSMassLocationFragment> Locations = Context.GetFragmentView<FWSMassLocationFragment>();
+
+		for (int32 i = 0; i < Context.GetNumEntities(); ++i)
+		{
+			TArray<FTransform>* Transforms = EnemySubsystem->GetVisualTransforms(Enemies[i].EnemyType);
+			if (Transforms)
+			{
+				Transforms->Emplace(Locations[i].Facing.ToOrientationQuat(), Locations[i].Location);
+			}
+		}
+	});
+}
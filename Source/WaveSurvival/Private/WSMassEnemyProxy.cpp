@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSMassEnemyProxy.h"
+#include "WSMassEnemySubsystem.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+
+void FWSMassEnemySnapshot::Reset()
+{
+	Types.Reset();
+	Locations.Reset();
+	Yaws.Reset();
+}
+
+bool FWSMassEnemySnapshot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << Sequence;
+
+	uint32 NumTypes = Types.Num();
+	Ar.SerializeIntPacked(NumTypes);
+	if (Ar.IsLoading())
+	{
+		if (NumTypes > MAX_uint8)
+		{
+			bOutSuccess = false;
+			return false;
+		}
+		Types.SetNum(NumTypes);
+	}
+
+	int32 NumEntities = 0;
+	for (FTypeRange& Range : Types)
+	{
+		uint8 EnemyType = (uint8)Range.EnemyType;
+		uint32 Count = Range.Count;
+		Ar << EnemyType;
+		Ar.SerializeIntPacked(Count);
+		Ar << Range.MovementSpeed;
+
+		Range.EnemyType = (EWSEnemyType)EnemyType;
+		Range.Count = (int32)FMath::Min(Count, (uint32)MaxEntities);
+		NumEntities += Range.Count;
+	}
+
+	if (Ar.IsLoading())
+	{
+		if (NumEntities > MaxEntities)
+		{
+			bOutSuccess = false;
+			return false;
+		}
+		Locations.SetNumUninitialized(NumEntities);
+		Yaws.SetNumUninitialized(NumEntities);
+	}
+
+	for (int32 i = 0; i < NumEntities; ++i)
+	{
+		int16 Quantized[3] = {0, 0, 0};
+		uint8 Yaw = 0;
+		if (Ar.IsSaving())
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Quantized[Axis] = (int16)FMath::Clamp(FMath::RoundToInt32(Locations[i][Axis] / LocationPrecision), (int32)MIN_int16, (int32)MAX_int16);
+			}
+			Yaw = FRotator::CompressAxisToByte(Yaws[i]);
+		}
+
+		Ar << Quantized[0] << Quantized[1] << Quantized[2] << Yaw;
+
+		if (Ar.IsLoading())
+		{
+			Locations[i] = FVector((float)Quantized[0], (float)Quantized[1], (float)Quantized[2]) * LocationPrecision;
+			Yaws[i] = FRotator::DecompressAxisFromByte(Yaw);
+		}
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+AWSMassEnemyProxy::AWSMassEnemyProxy()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	bReplicates = true;
+	bOnlyRelevantToOwner = true;
+	SetReplicatingMovement(false);
+
+	// Matches the subsystem's default snapshot interval
+	SetNetUpdateFrequency(10.0f);
+}
+
+void AWSMassEnemyProxy::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AWSMassEnemyProxy, Snapshot);
+}
+
+void AWSMassEnemyProxy::MarkSnapshotDirty()
+{
+	Snapshot.Sequence++;
+}
+
+void AWSMassEnemyProxy::OnRep_Snapshot()
+{
+	UWSMassEnemySubsystem* MassEnemies = GetWorld()->GetSubsystem<UWSMassEnemySubsystem>();
+	if (MassEnemies)
+	{
+		MassEnemies->ReceiveSnapshot(this);
+	}
+}
@@ -0,0 +1,653 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSMassEnemySubsystem.h"
+#include "WaveSurvival.h"
+#include "WSMassEnemyFragments.h"
+#include "WSMassEnemyProcessors.h"
+#include "WSMassEnemyProxy.h"
+#include "WSEnemyBase.h"
+#include "WSEnemyManagerSubsystem.h"
+#include "WSGameMode.h"
+#include "MassEntitySubsystem.h"
+#include "MassExecutor.h"
+#include "MassProcessingTypes.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Mass Enemy Update"), STAT_WSMassEnemyUpdate, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mass Enemy Entities"), STAT_WSMassEnemyEntities, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mass Enemy Promotions"), STAT_WSMassEnemyPromotions, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mass Enemy Demotions"), STAT_WSMassEnemyDemotions, STATGROUP_WaveSurvival);
+
+UWSMassEnemySubsystem::UWSMassEnemySubsystem()
+{
+	// Numerous, short-lived enemy types with no special behaviour
+	EntityEnemyTypes = {EWSEnemyType::Aalix, EWSEnemyType::Krals, EWSEnemyType::Gid, EWSEnemyType::QueenLarvae};
+
+	PromotionDistance = 3000.0f;
+	DemotionDistance = 4500.0f;
+	AimPromotionDistance = 8000.0f;
+	AimPromotionHalfAngle = 8.0f;
+	MaxPromotedActors = 400;
+	MaxPromotionsPerFrame = 16;
+	MaxDemotionsPerFrame = 16;
+	RetargetInterval = 0.5f;
+	SnapshotInterval = 0.1f;
+	MaxSnapshotEntities = 1024;
+
+	EntityCount = 0;
+	bIsServer = false;
+	bPublishSnapshots = false;
+	SnapshotAccumulator = 0.0f;
+	SnapshotReceiveTime = 0.0;
+}
+
+bool UWSMassEnemySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWSMassEnemySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UMassEntitySubsystem* MassSubsystem = Collection.InitializeDependency<UMassEntitySubsystem>();
+	if (!MassSubsystem)
+	{
+		return;
+	}
+
+	FMassEntityManager& EntityManager = MassSubsystem->GetMutableEntityManager();
+
+	TArray<const UScriptStruct*> Fragments;
+	Fragments.Add(FWSMassEnemyFragment::StaticStruct());
+	Fragments.Add(FWSMassLocationFragment::StaticStruct());
+	Fragments.Add(FWSMassTargetFragment::StaticStruct());
+	Fragments.Add(FWSMassHealthFragment::StaticStruct());
+	EnemyArchetype = EntityManager.CreateArchetype(Fragments);
+
+	// Run in this order every frame
+	Processors.Add(NewObject<UWSMassEnemyTargetingProcessor>(this));
+	Processors.Add(NewObject<UWSMassEnemyMovementProcessor>(this));
+	Processors.Add(NewObject<UWSMassEnemyVisualizationProcessor>(this));
+
+	for (UMassProcessor* Processor : Processors)
+	{
+		Processor->CallInitialize(this, EntityManager.AsShared());
+	}
+}
+
+void UWSMassEnemySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const ENetMode NetMode = InWorld.GetNetMode();
+	bIsServer = NetMode != NM_Client;
+
+	// Remote clients have no entities; they draw snapshots replicated by their proxies
+	bPublishSnapshots = bIsServer && NetMode != NM_Standalone;
+	if (bPublishSnapshots)
+	{
+		// The snapshot is built from the visual batches, so every type needs one even without a mesh
+		for (EWSEnemyType EnemyType : EntityEnemyTypes)
+		{
+			VisualBatches.FindOrAdd(EnemyType);
+		}
+	}
+
+	// Entities are only drawn for a local view
+	if (NetMode == NM_DedicatedServer || EntityVisualMeshes.Num() == 0)
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	VisualActor = InWorld.SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (!VisualActor)
+	{
+		return;
+	}
+
+	for (const TPair<EWSEnemyType, TSoftObjectPtr<UStaticMesh>>& Entry : EntityVisualMeshes)
+	{
+		UStaticMesh* Mesh = Entry.Value.LoadSynchronous();
+		if (!Mesh)
+		{
+			continue;
+		}
+
+		UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(VisualActor);
+		Instances->SetStaticMesh(Mesh);
+		Instances->SetMobility(EComponentMobility::Movable);
+		Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Instances->SetCastShadow(false);
+		Instances->RegisterComponent();
+
+		if (!VisualActor->GetRootComponent())
+		{
+			VisualActor->SetRootComponent(Instances);
+		}
+
+		VisualBatches.FindOrAdd(Entry.Key).Instances = Instances;
+	}
+}
+
+void UWSMassEnemySubsystem::Deinitialize()
+{
+	Processors.Empty();
+	VisualBatches.Empty();
+	VisualActor = nullptr;
+	ClientProxies.Empty();
+	Proxy = nullptr;
+	PromotionRequests.Empty();
+	EntityCount = 0;
+
+	Super::Deinitialize();
+}
+
+void UWSMassEnemySubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSMassEnemyUpdate);
+	SET_DWORD_STAT(STAT_WSMassEnemyEntities, EntityCount);
+
+	if (!bIsServer)
+	{
+		ExtrapolateSnapshot();
+		UpdateVisuals();
+		return;
+	}
+
+	UMassEntitySubsystem* MassSubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>();
+	if (!MassSubsystem)
+	{
+		return;
+	}
+
+	GatherPlayerViews();
+
+	for (TPair<EWSEnemyType, FVisualBatch>& Entry : VisualBatches)
+	{
+		Entry.Value.Transforms.Reset();
+	}
+
+	if (EntityCount > 0)
+	{
+		FMassProcessingContext ProcessingContext(MassSubsystem->GetMutableEntityManager(), DeltaTime);
+		UE::Mass::Executor::RunProcessorsView(Processors, ProcessingContext);
+	}
+
+	PromoteRequestedEntities();
+	DemoteDistantActors();
+	PublishSnapshot(DeltaTime);
+	UpdateVisuals();
+}
+
+TStatId UWSMassEnemySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWSMassEnemySubsystem, STATGROUP_Tickables);
+}
+
+bool UWSMassEnemySubsystem::IsEntityEnemyType(EWSEnemyType EnemyType) const
+{
+	return EntityEnemyTypes.Contains(EnemyType);
+}
+
+bool UWSMassEnemySubsystem::ShouldSimulateAsEntity(EWSEnemyType EnemyType, const FVector& Location) const
+{
+	if (!bIsServer || !EnemyArchetype.IsValid() || !IsEntityEnemyType(EnemyType))
+	{
+		return false;
+	}
+
+	float Priority;
+	return !ShouldPromote(Location, GetNearestPlayerDistSq(Location), Priority);
+}
+
+FMassEntityHandle UWSMassEnemySubsystem::SpawnEntity(EWSEnemyType EnemyType, const FVector& Location)
+{
+	UMassEntitySubsystem* MassSubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>();
+	AWSGameMode* WSGameMode = GetWorld()->GetAuthGameMode<AWSGameMode>();
+	if (!MassSubsystem || !WSGameMode)
+	{
+		return FMassEntityHandle();
+	}
+
+	TSubclassOf<AWSEnemyBase> EnemyClass = WSGameMode->GetEnemyClass(EnemyType);
+	if (!EnemyClass)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No class defined for enemy type %d"), (int32)EnemyType);
+		return FMassEntityHandle();
+	}
+
+	const AWSEnemyBase* DefaultEnemy = EnemyClass->GetDefaultObject<AWSEnemyBase>();
+	FMassEntityManager& EntityManager = MassSubsystem->GetMutableEntityManager();
+	const FMassEntityHandle Entity = EntityManager.CreateEntity(EnemyArchetype);
+
+	FWSMassEnemyFragment& Enemy = EntityManager.GetFragmentDataChecked<FWSMassEnemyFragment>(Entity);
+	Enemy.EnemyType = EnemyType;
+	Enemy.MovementSpeed = DefaultEnemy->EnemyStats.MovementSpeed;
+	Enemy.AttackRange = DefaultEnemy->AttackRange;
+
+	FWSMassLocationFragment& EntityLocation = EntityManager.GetFragmentDataChecked<FWSMassLocationFragment>(Entity);
+	EntityLocation.Location = Location;
+
+	// Stagger the first retarget so a freshly spawned wave doesn't retarget on the same frame
+	FWSMassTargetFragment& Target = EntityManager.GetFragmentDataChecked<FWSMassTargetFragment>(Entity);
+	Target.RetargetTimer = FMath::FRandRange(0.0f, RetargetInterval);
+
+	FWSMassHealthFragment& Health = EntityManager.GetFragmentDataChecked<FWSMassHealthFragment>(Entity);
+	Health.Health = DefaultEnemy->EnemyStats.MaxHealth;
+
+	EntityCount++;
+	return Entity;
+}
+
+int32 UWSMassEnemySubsystem::GetEntityCount() const
+{
+	return EntityCount;
+}
+
+int32 UWSMassEnemySubsystem::GetPromotedActorCount() const
+{
+	UWSEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UWSEnemyManagerSubsystem>();
+	if (!EnemyManager)
+	{
+		return 0;
+	}
+
+	int32 Count = 0;
+	for (EWSEnemyType EnemyType : EntityEnemyTypes)
+	{
+		Count += EnemyManager->GetEnemyCount(EnemyType);
+	}
+	return Count;
+}
+
+bool UWSMassEnemySubsystem::ShouldPromote(const FVector& Location, float NearestDistSq, float& OutPriority) const
+{
+	// Closer entities are promoted first
+	OutPriority = NearestDistSq;
+	if (NearestDistSq <= FMath::Square(PromotionDistance))
+	{
+		return true;
+	}
+
+	// Enemies a player is aiming at need real collision for hit detection
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(AimPromotionHalfAngle));
+	for (const FPlayerView& View : PlayerViews)
+	{
+		const FVector ToEnemy = Location - View.ViewLocation;
+		const float DistSq = ToEnemy.SizeSquared();
+		if (DistSq <= FMath::Square(AimPromotionDistance)
+			&& FVector::DotProduct(ToEnemy, View.AimDirection) >= CosHalfAngle * FMath::Sqrt(DistSq))
+		{
+			// Rank aimed-at enemies behind everything inside the promotion radius
+			OutPriority += FMath::Square(PromotionDistance);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UWSMassEnemySubsystem::RequestPromotion(const FMassEntityHandle& Entity, float Priority)
+{
+	PromotionRequests.Add({Entity, Priority});
+}
+
+TArray<FTransform>* UWSMassEnemySubsystem::GetVisualTransforms(EWSEnemyType EnemyType)
+{
+	FVisualBatch* Batch = VisualBatches.Find(EnemyType);
+	return Batch ? &Batch->Transforms : nullptr;
+}
+
+void UWSMassEnemySubsystem::GatherPlayerViews()
+{
+	PlayerViews.Reset();
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+		if (Pawn)
+		{
+			// For remote players this is the camera their client last sent, not the server's own guess
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			PlayerViews.Add({Pawn->GetActorLocation(), ViewLocation, ViewRotation.Vector()});
+		}
+	}
+}
+
+void UWSMassEnemySubsystem::PromoteRequestedEntities()
+{
+	if (PromotionRequests.Num() == 0)
+	{
+		return;
+	}
+
+	UMassEntitySubsystem* MassSubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>();
+	AWSGameMode* WSGameMode = GetWorld()->GetAuthGameMode<AWSGameMode>();
+	if (!MassSubsystem || !WSGameMode)
+	{
+		PromotionRequests.Reset();
+		return;
+	}
+
+	FMassEntityManager& EntityManager = MassSubsystem->GetMutableEntityManager();
+	const int32 Budget = FMath::Min(MaxPromotionsPerFrame, MaxPromotedActors - GetPromotedActorCount());
+
+	PromotionRequests.Sort([](const FPromotionRequest& A, const FPromotionRequest& B)
+	{
+		return A.Priority < B.Priority;
+	});
+
+	// Requests over budget are dropped; those entities ask again on their next retarget
+	int32 Promoted = 0;
+	for (const FPromotionRequest& Request : PromotionRequests)
+	{
+		if (Promoted >= Budget)
+		{
+			break;
+		}
+
+		if (!EntityManager.IsEntityValid(Request.Entity))
+		{
+			continue;
+		}
+
+		const FWSMassEnemyFragment& Enemy = EntityManager.GetFragmentDataChecked<FWSMassEnemyFragment>(Request.Entity);
+		const FWSMassLocationFragment& Location = EntityManager.GetFragmentDataChecked<FWSMassLocationFragment>(Request.Entity);
+		const FWSMassHealthFragment& Health = EntityManager.GetFragmentDataChecked<FWSMassHealthFragment>(Request.Entity);
+
+		AWSEnemyBase* EnemyActor = WSGameMode->AcquireEnemy(Enemy.EnemyType, Location.Location);
+		if (!EnemyActor)
+		{
+			continue;
+		}
+
+		EnemyActor->SetActorRotation(Location.Facing.Rotation());
+		EnemyActor->ApplyPromotedState(Health.Health, Health.DamageLedger);
+
+		EntityManager.DestroyEntity(Request.Entity);
+		EntityCount--;
+		Promoted++;
+	}
+
+	SET_DWORD_STAT(STAT_WSMassEnemyPromotions, Promoted);
+	PromotionRequests.Reset();
+}
+
+void UWSMassEnemySubsystem::DemoteDistantActors()
+{
+	UWSEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UWSEnemyManagerSubsystem>();
+	AWSGameMode* WSGameMode = GetWorld()->GetAuthGameMode<AWSGameMode>();
+	UMassEntitySubsystem* MassSubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>();
+	if (!EnemyManager || !WSGameMode || !MassSubsystem || PlayerViews.Num() == 0)
+	{
+		return;
+	}
+
+	const float DemotionDistSq = FMath::Square(DemotionDistance);
+	int32 Demoted = 0;
+
+	for (EWSEnemyType EnemyType : EntityEnemyTypes)
+	{
+		const FWSEnemyBatch& Batch = EnemyManager->GetBatch(EnemyType);
+
+		// Releasing swap-removes from the batch, so walk it backwards
+		for (int32 i = Batch.Num() - 1; i >= 0 && Demoted < MaxDemotionsPerFrame; --i)
+		{
+			AWSEnemyBase* EnemyActor = Batch.Enemies[i];
+			const float NearestDistSq = GetNearestPlayerDistSq(Batch.Positions[i]);
+			if (EnemyActor->bIsBoss || EnemyActor->EnemyStats.CurrentHealth <= 0.0f || NearestDistSq <= DemotionDistSq)
+			{
+				continue;
+			}
+
+			// Keep actors a player is aiming at, otherwise they'd be promoted straight back
+			float Priority;
+			if (ShouldPromote(Batch.Positions[i], NearestDistSq, Priority))
+			{
+				continue;
+			}
+
+			const FMassEntityHandle Entity = SpawnEntity(EnemyType, Batch.Positions[i]);
+			if (!Entity.IsSet())
+			{
+				continue;
+			}
+
+			FMassEntityManager& EntityManager = MassSubsystem->GetMutableEntityManager();
+			FWSMassHealthFragment& Health = EntityManager.GetFragmentDataChecked<FWSMassHealthFragment>(Entity);
+			Health.Health = EnemyActor->EnemyStats.CurrentHealth;
+			Health.DamageLedger = EnemyActor->GetDamageLedger();
+
+			EntityManager.GetFragmentDataChecked<FWSMassLocationFragment>(Entity).Facing = EnemyActor->GetActorForwardVector();
+
+			WSGameMode->ReleaseEnemy(EnemyActor);
+			Demoted++;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_WSMassEnemyDemotions, Demoted);
+}
+
+void UWSMassEnemySubsystem::ReceiveSnapshot(AWSMassEnemyProxy* InProxy)
+{
+	Proxy = InProxy;
+	SnapshotReceiveTime = GetWorld()->GetTimeSeconds();
+}
+
+void UWSMassEnemySubsystem::UpdateClientProxies()
+{
+	// Proxies of players who left
+	for (int32 i = ClientProxies.Num() - 1; i >= 0; --i)
+	{
+		AWSMassEnemyProxy* ClientProxy = ClientProxies[i];
+		if (!IsValid(ClientProxy) || !IsValid(ClientProxy->GetOwner()))
+		{
+			if (IsValid(ClientProxy))
+			{
+				ClientProxy->Destroy();
+			}
+			ClientProxies.RemoveAtSwap(i);
+		}
+	}
+
+	// The host draws its own batches, so only remote players get a proxy
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		if (!PC || PC->IsLocalController()
+			|| ClientProxies.ContainsByPredicate([PC](const AWSMassEnemyProxy* ClientProxy) { return ClientProxy->GetOwner() == PC; }))
+		{
+			continue;
+		}
+
+		FActorSpawnParameters ProxyParams;
+		ProxyParams.Owner = PC;
+		ProxyParams.ObjectFlags |= RF_Transient;
+		AWSMassEnemyProxy* ClientProxy = GetWorld()->SpawnActor<AWSMassEnemyProxy>(AWSMassEnemyProxy::StaticClass(), FTransform::Identity, ProxyParams);
+		if (ClientProxy)
+		{
+			ClientProxy->SetNetUpdateFrequency(1.0f / FMath::Max(SnapshotInterval, 0.01f));
+			ClientProxies.Add(ClientProxy);
+		}
+	}
+}
+
+void UWSMassEnemySubsystem::PublishSnapshot(float DeltaTime)
+{
+	if (!bPublishSnapshots)
+	{
+		return;
+	}
+
+	SnapshotAccumulator += DeltaTime;
+	if (SnapshotAccumulator < SnapshotInterval)
+	{
+		return;
+	}
+	SnapshotAccumulator = FMath::Min(SnapshotAccumulator - SnapshotInterval, SnapshotInterval);
+
+	UpdateClientProxies();
+	if (ClientProxies.Num() == 0)
+	{
+		return;
+	}
+
+	AWSGameMode* WSGameMode = GetWorld()->GetAuthGameMode<AWSGameMode>();
+	AllEntities.Reset();
+	EntityTypeIndices.Reset();
+
+	for (const TPair<EWSEnemyType, FVisualBatch>& Entry : VisualBatches)
+	{
+		const TArray<FTransform>& Transforms = Entry.Value.Transforms;
+		if (Transforms.Num() == 0)
+		{
+			continue;
+		}
+
+		TSubclassOf<AWSEnemyBase> EnemyClass = WSGameMode ? WSGameMode->GetEnemyClass(Entry.Key) : nullptr;
+
+		const uint8 TypeIndex = (uint8)AllEntities.Types.Num();
+		FWSMassEnemySnapshot::FTypeRange& Range = AllEntities.Types.AddDefaulted_GetRef();
+		Range.EnemyType = Entry.Key;
+		Range.Count = Transforms.Num();
+		Range.MovementSpeed = EnemyClass ? EnemyClass->GetDefaultObject<AWSEnemyBase>()->EnemyStats.MovementSpeed : 0.0f;
+
+		for (const FTransform& Transform : Transforms)
+		{
+			AllEntities.Locations.Add(Transform.GetLocation());
+			AllEntities.Yaws.Add((float)Transform.Rotator().Yaw);
+			EntityTypeIndices.Add(TypeIndex);
+		}
+	}
+
+	for (AWSMassEnemyProxy* ClientProxy : ClientProxies)
+	{
+		// For remote players this is the camera their client last sent
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		CastChecked<APlayerController>(ClientProxy->GetOwner())->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		FillClientSnapshot(ClientProxy->EditSnapshot(), ViewLocation);
+		ClientProxy->MarkSnapshotDirty();
+	}
+}
+
+void UWSMassEnemySubsystem::FillClientSnapshot(FWSMassEnemySnapshot& Snapshot, const FVector& ViewLocation)
+{
+	Snapshot.Reset();
+
+	const int32 Budget = FMath::Clamp(MaxSnapshotEntities, 0, FWSMassEnemySnapshot::MaxEntities);
+	if (AllEntities.Locations.Num() <= Budget)
+	{
+		Snapshot.Types = AllEntities.Types;
+		Snapshot.Locations = AllEntities.Locations;
+		Snapshot.Yaws = AllEntities.Yaws;
+		return;
+	}
+
+	// Over budget: the entities nearest this client's view, found with a partial heap sort
+	EntityDistances.Reset();
+	for (int32 i = 0; i < AllEntities.Locations.Num(); ++i)
+	{
+		EntityDistances.Emplace((float)FVector::DistSquared(AllEntities.Locations[i], ViewLocation), i);
+	}
+
+	const auto IsNearer = [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; };
+	EntityDistances.Heapify(IsNearer);
+
+	PickedEntities.Reset();
+	for (int32 Picked = 0; Picked < Budget; ++Picked)
+	{
+		TPair<float, int32> Nearest;
+		EntityDistances.HeapPop(Nearest, IsNearer, EAllowShrinking::No);
+		PickedEntities.Add(Nearest.Value);
+	}
+
+	// Back in batch order so the picks stay grouped by type
+	PickedEntities.Sort();
+
+	int32 TypeIndex = INDEX_NONE;
+	for (const int32 Index : PickedEntities)
+	{
+		if (EntityTypeIndices[Index] != TypeIndex)
+		{
+			TypeIndex = EntityTypeIndices[Index];
+			FWSMassEnemySnapshot::FTypeRange& Range = Snapshot.Types.Add_GetRef(AllEntities.Types[TypeIndex]);
+			Range.Count = 0;
+		}
+
+		Snapshot.Types.Last().Count++;
+		Snapshot.Locations.Add(AllEntities.Locations[Index]);
+		Snapshot.Yaws.Add(AllEntities.Yaws[Index]);
+	}
+}
+
+void UWSMassEnemySubsystem::ExtrapolateSnapshot()
+{
+	for (TPair<EWSEnemyType, FVisualBatch>& Entry : VisualBatches)
+	{
+		Entry.Value.Transforms.Reset();
+	}
+
+	if (!Proxy)
+	{
+		return;
+	}
+
+	// Entities move in a straight line between updates; a late snapshot mustn't send them flying
+	const float Elapsed = (float)FMath::Min(GetWorld()->GetTimeSeconds() - SnapshotReceiveTime, 2.0 * SnapshotInterval);
+	const FWSMassEnemySnapshot& Snapshot = Proxy->GetSnapshot();
+
+	int32 First = 0;
+	for (const FWSMassEnemySnapshot::FTypeRange& Range : Snapshot.Types)
+	{
+		TArray<FTransform>* Transforms = GetVisualTransforms(Range.EnemyType);
+		for (int32 i = First; Transforms && i < First + Range.Count; ++i)
+		{
+			const FRotator Facing(0.0f, Snapshot.Yaws[i], 0.0f);
+			Transforms->Emplace(Facing, Snapshot.Locations[i] + Facing.Vector() * Range.MovementSpeed * Elapsed);
+		}
+		First += Range.Count;
+	}
+}
+
+void UWSMassEnemySubsystem::UpdateVisuals()
+{
+	for (TPair<EWSEnemyType, FVisualBatch>& Entry : VisualBatches)
+	{
+		FVisualBatch& Batch = Entry.Value;
+		if (!Batch.Instances)
+		{
+			continue;
+		}
+
+		if (Batch.Instances->GetInstanceCount() != Batch.Transforms.Num())
+		{
+			Batch.Instances->ClearInstances();
+			Batch.Instances->AddInstances(Batch.Transforms, false, true);
+		}
+		else if (Batch.Transforms.Num() > 0)
+		{
+			Batch.Instances->BatchUpdateInstancesTransforms(0, Batch.Transforms, true, true);
+		}
+	}
+}
+
+float UWSMassEnemySubsystem::GetNearestPlayerDistSq(const FVector& Location) const
+{
+	float NearestDistSq = FLT_MAX;
+	for (const FPlayerView& View : PlayerViews)
+	{
+		NearestDistSq = FMath::Min(NearestDistSq, FVector::DistSquared(Location, View.Location));
+	}
+	return NearestDistSq;
+}
@@ -2,9 +2,11 @@
 
 #include "WSPlayerState.h"
 #include "Net/UnrealNetwork.h"
+#include "GameFramework/Pawn.h"
 
 AWSPlayerState::AWSPlayerState()
 {
+	PlayerSlot = INDEX_NONE;
 	CharacterClass = EWSCharacterClass::Rogue;
 	CurrentState = EWSPlayerState::Alive;
 	
@@ -21,6 +23,7 @@ void AWSPlayerState::BeginPlay()
 	
 	// Initialize player stats based on character class
 	PlayerStats = FWSPlayerStats();
+	OnCombatStatsChanged.Broadcast();
 	
 	UE_LOG(LogTemp, Log, TEXT("Player State initialized for class %d"), (int32)CharacterClass);
 }
@@ -186,15 +189,40 @@ void AWSPlayerState::ApplyUpgradeEffects(const FWSUpgradeCardData& UpgradeCard)
 		PlayerStats.MovementSpeedMultiplier += Value;
 	}
 	
+	OnCombatStatsChanged.Broadcast();
+
 	UE_LOG(LogTemp, Log, TEXT("Applied upgrade effect: %s with value %f"), 
 		*EffectID.ToString(), Value);
 }
 
+int32 AWSPlayerState::GetPlayerSlotForActor(const AActor* DamageCauser)
+{
+	const APawn* Pawn = Cast<APawn>(DamageCauser);
+	if (!Pawn)
+	{
+		return INDEX_NONE;
+	}
+
+	const AWSPlayerState* PS = Pawn->GetPlayerState<AWSPlayerState>();
+	return PS ? PS->PlayerSlot : INDEX_NONE;
+}
+
+void AWSPlayerState::OnRep_PlayerStats()
+{
+	OnCombatStatsChanged.Broadcast();
+}
+
+void AWSPlayerState::OnRep_PlayerSlot()
+{
+	OnCombatStatsChanged.Broadcast();
+}
+
 void AWSPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
 	DOREPLIFETIME(AWSPlayerState, PlayerStats);
+	DOREPLIFETIME(AWSPlayerState, PlayerSlot);
 	DOREPLIFETIME(AWSPlayerState, CharacterClass);
 	DOREPLIFETIME(AWSPlayerState, CurrentState);
 	DOREPLIFETIME(AWSPlayerState, Currency);
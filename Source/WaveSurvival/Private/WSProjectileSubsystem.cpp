@@ -0,0 +1,301 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSProjectileSubsystem.h"
+#include "WaveSurvival.h"
+#include "WSWeaponBase.h"
+#include "WSEnemyBase.h"
+#include "WSSpatialGridSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Update"), STAT_WSProjectileUpdate, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Live Projectiles"), STAT_WSLiveProjectiles, STATGROUP_WaveSurvival);
+
+UWSProjectileSubsystem::UWSProjectileSubsystem()
+{
+	MaxSubstepDistance = 250.0f;
+	EnemyQueryPadding = 100.0f;
+
+	StressFramesRemaining = 0;
+	StressFramesTotal = 0;
+	StressAccumulatedMs = 0.0;
+}
+
+bool UWSProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWSProjectileSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (InWorld.GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	UStaticMesh* Mesh = ProjectileMesh.LoadSynchronous();
+	if (!Mesh)
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	VisualActor = InWorld.SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (!VisualActor)
+	{
+		return;
+	}
+
+	VisualInstances = NewObject<UInstancedStaticMeshComponent>(VisualActor);
+	VisualInstances->SetStaticMesh(Mesh);
+	VisualInstances->SetMobility(EComponentMobility::Movable);
+	VisualInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	VisualInstances->SetCastShadow(false);
+	VisualInstances->RegisterComponent();
+	VisualActor->SetRootComponent(VisualInstances);
+}
+
+void UWSProjectileSubsystem::Deinitialize()
+{
+	Positions.Empty();
+	Velocities.Empty();
+	RemainingDistances.Empty();
+	Radii.Empty();
+	Weapons.Empty();
+
+	VisualInstances = nullptr;
+	VisualActor = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UWSProjectileSubsystem::Tick(float DeltaTime)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_WSProjectileUpdate);
+
+		FCollisionObjectQueryParams WorldObjects;
+		WorldObjects.AddObjectTypesToQuery(ECC_WorldStatic);
+		WorldObjects.AddObjectTypesToQuery(ECC_WorldDynamic);
+		const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WSProjectile));
+
+		// Iterate backwards so swap-removal doesn't skip anything
+		for (int32 i = Positions.Num() - 1; i >= 0; --i)
+		{
+			const FVector Start = Positions[i];
+			const float StepDistance = FMath::Min(Velocities[i].Size() * DeltaTime, RemainingDistances[i]);
+			const FVector Direction = Velocities[i].GetSafeNormal();
+			FVector End = Start + Direction * StepDistance;
+
+			// World geometry is static, so one trace covers the whole frame
+			FHitResult WorldHit;
+			const bool bHitWorld = GetWorld()->LineTraceSingleByObjectType(WorldHit, Start, End, WorldObjects, QueryParams);
+			if (bHitWorld)
+			{
+				End = WorldHit.Location;
+			}
+
+			if (SweepEnemies(i, Start, End) || bHitWorld || StepDistance >= RemainingDistances[i])
+			{
+				RemoveProjectile(i);
+				continue;
+			}
+
+			Positions[i] = End;
+			RemainingDistances[i] -= StepDistance;
+		}
+
+		SET_DWORD_STAT(STAT_WSLiveProjectiles, Positions.Num());
+		UpdateVisuals();
+	}
+
+	if (StressFramesRemaining > 0)
+	{
+		StressAccumulatedMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		if (--StressFramesRemaining == 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("Projectile stress test: %.3f ms average update over %d frames, %d projectiles still live"),
+				StressAccumulatedMs / StressFramesTotal, StressFramesTotal, Positions.Num());
+		}
+	}
+}
+
+TStatId UWSProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWSProjectileSubsystem, STATGROUP_Tickables);
+}
+
+void UWSProjectileSubsystem::SpawnProjectile(AWSWeaponBase* Weapon, const FVector& Location, const FVector& Velocity, float MaxDistance, float Radius)
+{
+	if (Velocity.IsNearlyZero() || MaxDistance <= 0.0f)
+	{
+		return;
+	}
+
+	Positions.Add(Location);
+	Velocities.Add(Velocity);
+	RemainingDistances.Add(MaxDistance);
+	Radii.Add(Radius);
+	Weapons.Add(Weapon);
+}
+
+int32 UWSProjectileSubsystem::GetProjectileCount() const
+{
+	return Positions.Num();
+}
+
+void UWSProjectileSubsystem::RunStressTest(int32 Count, int32 Frames)
+{
+	FVector Origin = FVector::ZeroVector;
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (PC && PC->GetPawn())
+	{
+		Origin = PC->GetPawn()->GetActorLocation();
+	}
+
+	// Long-lived, slow projectiles so the whole batch stays alive for the measurement
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const FVector Direction = FMath::VRand().GetSafeNormal2D();
+		SpawnProjectile(nullptr, Origin + FVector(0.0f, 0.0f, 100.0f), Direction * 500.0f, 100000.0f, 10.0f);
+	}
+
+	StressFramesTotal = FMath::Max(1, Frames);
+	StressFramesRemaining = StressFramesTotal;
+	StressAccumulatedMs = 0.0;
+
+	UE_LOG(LogTemp, Log, TEXT("Projectile stress test: spawned %d projectiles, measuring %d frames"), Count, StressFramesTotal);
+}
+
+void UWSProjectileSubsystem::RemoveProjectile(int32 Index)
+{
+	Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RemainingDistances.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Radii.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Weapons.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+bool UWSProjectileSubsystem::SweepEnemies(int32 Index, const FVector& Start, const FVector& End)
+{
+	UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (!SpatialGrid)
+	{
+		return false;
+	}
+
+	const float Distance = FVector::Dist(Start, End);
+	const int32 NumSubsteps = FMath::Max(1, FMath::CeilToInt(Distance / MaxSubstepDistance));
+	const float Radius = Radii[Index];
+
+	for (int32 Substep = 0; Substep < NumSubsteps; ++Substep)
+	{
+		const FVector SubStart = FMath::Lerp(Start, End, (float)Substep / NumSubsteps);
+		const FVector SubEnd = FMath::Lerp(Start, End, (float)(Substep + 1) / NumSubsteps);
+		const FVector Center = (SubStart + SubEnd) * 0.5f;
+		const float QueryRadius = FVector::Dist(SubStart, SubEnd) * 0.5f + Radius + EnemyQueryPadding;
+
+		if (SpatialGrid->QueryRadius(Center, QueryRadius, EWSSpatialCategory::Enemy, Candidates) == 0)
+		{
+			continue;
+		}
+
+		// Closest capsule along this sub-step wins
+		AWSEnemyBase* HitEnemy = nullptr;
+		float HitDistSq = FLT_MAX;
+
+		for (AActor* Candidate : Candidates)
+		{
+			AWSEnemyBase* Enemy = Cast<AWSEnemyBase>(Candidate);
+			if (!Enemy || Enemy->IsPooled())
+			{
+				continue;
+			}
+
+			float CapsuleRadius;
+			float CapsuleHalfHeight;
+			Enemy->GetCapsuleComponent()->GetScaledCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+
+			float DistSq;
+			if (SweepCapsule(SubStart, SubEnd, Radius, Enemy->GetActorLocation(), CapsuleRadius, CapsuleHalfHeight, DistSq) && DistSq < HitDistSq)
+			{
+				HitDistSq = DistSq;
+				HitEnemy = Enemy;
+			}
+		}
+
+		if (HitEnemy)
+		{
+			AWSWeaponBase* Weapon = Weapons[Index].Get();
+			if (Weapon)
+			{
+				Weapon->DamageEnemy(HitEnemy, 1.0f);
+			}
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UWSProjectileSubsystem::SweepCapsule(const FVector& Start, const FVector& End, float Radius, const FVector& CapsuleCenter,
+	float CapsuleRadius, float CapsuleHalfHeight, float& OutDistSq)
+{
+	const FVector AxisOffset(0.0f, 0.0f, FMath::Max(0.0f, CapsuleHalfHeight - CapsuleRadius));
+
+	FVector PointOnPath;
+	FVector PointOnAxis;
+	FMath::SegmentDistToSegmentSafe(Start, End, CapsuleCenter - AxisOffset, CapsuleCenter + AxisOffset, PointOnPath, PointOnAxis);
+
+	OutDistSq = (float)FVector::DistSquared(Start, PointOnPath);
+	return FVector::DistSquared(PointOnPath, PointOnAxis) <= FMath::Square(CapsuleRadius + Radius);
+}
+
+void UWSProjectileSubsystem::UpdateVisuals()
+{
+	if (!VisualInstances)
+	{
+		return;
+	}
+
+	VisualTransforms.Reset(Positions.Num());
+	for (int32 i = 0; i < Positions.Num(); ++i)
+	{
+		VisualTransforms.Emplace(Velocities[i].ToOrientationQuat(), Positions[i]);
+	}
+
+	if (VisualInstances->GetInstanceCount() != VisualTransforms.Num())
+	{
+		VisualInstances->ClearInstances();
+		VisualInstances->AddInstances(VisualTransforms, false, true);
+	}
+	else if (VisualTransforms.Num() > 0)
+	{
+		VisualInstances->BatchUpdateInstancesTransforms(0, VisualTransforms, true, true);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs GWSProjectileStressCommand(
+	TEXT("ws.Projectiles.Stress"),
+	TEXT("Spawns harmless projectiles and logs the average update cost. Usage: ws.Projectiles.Stress [Count=5000] [Frames=120]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UWSProjectileSubsystem* Projectiles = World ? World->GetSubsystem<UWSProjectileSubsystem>() : nullptr;
+		if (Projectiles)
+		{
+			const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 5000;
+			const int32 Frames = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 120;
+			Projectiles->RunStressTest(Count, Frames);
+		}
+	}));
+#endif
@@ -0,0 +1,571 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSSpatialGridSubsystem.h"
+#include "WaveSurvival.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spatial Grid Refresh"), STAT_WSSpatialGridRefresh, STATGROUP_WaveSurvival);
+
+namespace
+{
+	// Below this many entries a linear scan beats walking grid rings
+	constexpr int32 BruteForceEntryLimit = 16;
+}
+
+UWSSpatialGridSubsystem::UWSSpatialGridSubsystem()
+{
+	CellSize = 1000.0f;
+}
+
+template <typename VisitorType>
+void UWSSpatialGridSubsystem::ForEachEntryInSquare(const FLayer& Layer, const FVector& Location, float HalfExtent, VisitorType&& Visitor) const
+{
+	if (Layer.Entries.Num() <= BruteForceEntryLimit)
+	{
+		for (int32 EntryIndex = 0; EntryIndex < Layer.Entries.Num(); ++EntryIndex)
+		{
+			Visitor(EntryIndex);
+		}
+		return;
+	}
+
+	const FIntPoint MinCell = GetCell(Location - FVector(HalfExtent, HalfExtent, 0.0f));
+	const FIntPoint MaxCell = GetCell(Location + FVector(HalfExtent, HalfExtent, 0.0f));
+
+	for (int32 X = FMath::Max(MinCell.X, Layer.MinCell.X); X <= FMath::Min(MaxCell.X, Layer.MaxCell.X); ++X)
+	{
+		for (int32 Y = FMath::Max(MinCell.Y, Layer.MinCell.Y); Y <= FMath::Min(MaxCell.Y, Layer.MaxCell.Y); ++Y)
+		{
+			const TArray<int32>* Cell = Layer.Cells.Find(FIntPoint(X, Y));
+			if (Cell)
+			{
+				for (int32 EntryIndex : *Cell)
+				{
+					Visitor(EntryIndex);
+				}
+			}
+		}
+	}
+}
+
+bool UWSSpatialGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWSSpatialGridSubsystem::Deinitialize()
+{
+	for (FLayer& Layer : Layers)
+	{
+		Layer = FLayer();
+	}
+
+	Super::Deinitialize();
+}
+
+void UWSSpatialGridSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSSpatialGridRefresh);
+
+	for (FLayer& Layer : Layers)
+	{
+		RefreshLayer(Layer);
+	}
+}
+
+TStatId UWSSpatialGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWSSpatialGridSubsystem, STATGROUP_Tickables);
+}
+
+void UWSSpatialGridSubsystem::RegisterActor(AActor* Actor, EWSSpatialCategory Category)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	FLayer& Layer = GetLayer(Category);
+	if (Layer.EntryIndices.Contains(Actor))
+	{
+		return;
+	}
+
+	FEntry Entry;
+	Entry.Actor = Actor;
+	Entry.Location = Actor->GetActorLocation();
+	Entry.Cell = GetCell(Entry.Location);
+
+	const int32 EntryIndex = Layer.Entries.Add(Entry);
+	Layer.EntryIndices.Add(Actor, EntryIndex);
+	AddToCell(Layer, Entry.Cell, EntryIndex);
+
+	if (Layer.Entries.Num() == 1)
+	{
+		Layer.MinCell = Entry.Cell;
+		Layer.MaxCell = Entry.Cell;
+	}
+	else
+	{
+		Layer.MinCell = FIntPoint(FMath::Min(Layer.MinCell.X, Entry.Cell.X), FMath::Min(Layer.MinCell.Y, Entry.Cell.Y));
+		Layer.MaxCell = FIntPoint(FMath::Max(Layer.MaxCell.X, Entry.Cell.X), FMath::Max(Layer.MaxCell.Y, Entry.Cell.Y));
+	}
+}
+
+void UWSSpatialGridSubsystem::UnregisterActor(AActor* Actor)
+{
+	for (FLayer& Layer : Layers)
+	{
+		int32 EntryIndex = INDEX_NONE;
+		if (!Layer.EntryIndices.RemoveAndCopyValue(Actor, EntryIndex))
+		{
+			continue;
+		}
+
+		RemoveFromCell(Layer, Layer.Entries[EntryIndex].Cell, EntryIndex);
+
+		// Swap the last entry into the hole and patch its cell reference
+		const int32 LastIndex = Layer.Entries.Num() - 1;
+		if (EntryIndex != LastIndex)
+		{
+			const FEntry& Moved = Layer.Entries[LastIndex];
+			RemoveFromCell(Layer, Moved.Cell, LastIndex);
+			AddToCell(Layer, Moved.Cell, EntryIndex);
+			Layer.EntryIndices[Moved.Actor] = EntryIndex;
+		}
+
+		Layer.Entries.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	}
+}
+
+AActor* UWSSpatialGridSubsystem::FindNearest(FVector Location, EWSSpatialCategory Category, float MaxRadius) const
+{
+	const FLayer& Layer = GetLayer(Category);
+
+	float BestDistSq = MaxRadius > 0.0f ? FMath::Square(MaxRadius) : FLT_MAX;
+	AActor* BestActor = nullptr;
+
+	if (Layer.Entries.Num() <= BruteForceEntryLimit)
+	{
+		for (const FEntry& Entry : Layer.Entries)
+		{
+			const float DistSq = FVector::DistSquared(Location, Entry.Location);
+			if (DistSq < BestDistSq)
+			{
+				BestDistSq = DistSq;
+				BestActor = Entry.Actor;
+			}
+		}
+
+		return BestActor;
+	}
+
+	TArray<AActor*> Result;
+	FindNearestN(Location, Category, 1, Result, MaxRadius);
+	return Result.Num() > 0 ? Result[0] : nullptr;
+}
+
+int32 UWSSpatialGridSubsystem::FindNearestN(FVector Location, EWSSpatialCategory Category, int32 Count, TArray<AActor*>& OutActors, float MaxRadius) const
+{
+	OutActors.Reset();
+
+	const FLayer& Layer = GetLayer(Category);
+	if (Count <= 0 || Layer.Entries.Num() == 0)
+	{
+		return 0;
+	}
+
+	const float MaxDistSq = MaxRadius > 0.0f ? FMath::Square(MaxRadius) : FLT_MAX;
+
+	// Best candidates so far, kept sorted by distance
+	struct FCandidate
+	{
+		int32 EntryIndex;
+		float DistSq;
+	};
+	TArray<FCandidate, TInlineAllocator<16>> Best;
+
+	auto Consider = [&](int32 EntryIndex)
+	{
+		const float DistSq = FVector::DistSquared(Location, Layer.Entries[EntryIndex].Location);
+		if (DistSq > MaxDistSq || (Best.Num() == Count && DistSq >= Best.Last().DistSq))
+		{
+			return;
+		}
+
+		int32 InsertAt = Best.Num();
+		while (InsertAt > 0 && Best[InsertAt - 1].DistSq > DistSq)
+		{
+			InsertAt--;
+		}
+		Best.Insert({EntryIndex, DistSq}, InsertAt);
+
+		if (Best.Num() > Count)
+		{
+			Best.Pop(EAllowShrinking::No);
+		}
+	};
+
+	if (Layer.Entries.Num() <= BruteForceEntryLimit)
+	{
+		for (int32 EntryIndex = 0; EntryIndex < Layer.Entries.Num(); ++EntryIndex)
+		{
+			Consider(EntryIndex);
+		}
+	}
+	else
+	{
+		// Walk square rings of cells outward until no closer entry can exist
+		const FIntPoint Center = GetCell(Location);
+		const int32 MaxRing = FMath::Max(
+			FMath::Max(FMath::Abs(Center.X - Layer.MinCell.X), FMath::Abs(Layer.MaxCell.X - Center.X)),
+			FMath::Max(FMath::Abs(Center.Y - Layer.MinCell.Y), FMath::Abs(Layer.MaxCell.Y - Center.Y)));
+		const int32 RadiusRing = MaxRadius > 0.0f ? FMath::CeilToInt(MaxRadius / CellSize) : MaxRing;
+
+		for (int32 Ring = 0; Ring <= FMath::Min(MaxRing, RadiusRing); ++Ring)
+		{
+			// Cells in this ring are at least (Ring - 1) cells away
+			if (Best.Num() == Count && FMath::Square((Ring - 1) * CellSize) >= Best.Last().DistSq)
+			{
+				break;
+			}
+
+			for (int32 X = Center.X - Ring; X <= Center.X + Ring; ++X)
+			{
+				const bool bEdgeColumn = (X == Center.X - Ring || X == Center.X + Ring);
+				const int32 StepY = bEdgeColumn ? 1 : FMath::Max(1, 2 * Ring);
+
+				for (int32 Y = Center.Y - Ring; Y <= Center.Y + Ring; Y += StepY)
+				{
+					const TArray<int32>* Cell = Layer.Cells.Find(FIntPoint(X, Y));
+					if (Cell)
+					{
+						for (int32 EntryIndex : *Cell)
+						{
+							Consider(EntryIndex);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	for (const FCandidate& Candidate : Best)
+	{
+		OutActors.Add(Layer.Entries[Candidate.EntryIndex].Actor);
+	}
+
+	return OutActors.Num();
+}
+
+int32 UWSSpatialGridSubsystem::QueryRadius(FVector Location, float Radius, EWSSpatialCategory Category, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reset();
+
+	const FLayer& Layer = GetLayer(Category);
+	const float RadiusSq = FMath::Square(Radius);
+
+	ForEachEntryInSquare(Layer, Location, Radius, [&](int32 EntryIndex)
+	{
+		const FEntry& Entry = Layer.Entries[EntryIndex];
+		if (FVector::DistSquared(Location, Entry.Location) <= RadiusSq)
+		{
+			OutActors.Add(Entry.Actor);
+		}
+	});
+
+	return OutActors.Num();
+}
+
+int32 UWSSpatialGridSubsystem::QueryCone(FVector Origin, FVector Direction, float Range, float HalfAngleDegrees, EWSSpatialCategory Category, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reset();
+
+	const FLayer& Layer = GetLayer(Category);
+	const FVector Forward = Direction.GetSafeNormal();
+	const float RangeSq = FMath::Square(Range);
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(HalfAngleDegrees));
+
+	ForEachEntryInSquare(Layer, Origin, Range, [&](int32 EntryIndex)
+	{
+		const FEntry& Entry = Layer.Entries[EntryIndex];
+		const FVector ToEntry = Entry.Location - Origin;
+		const float DistSq = ToEntry.SizeSquared();
+		if (DistSq > RangeSq)
+		{
+			return;
+		}
+
+		// Entries at the origin count as inside the cone
+		if (DistSq > KINDA_SMALL_NUMBER && FVector::DotProduct(ToEntry, Forward) < CosHalfAngle * FMath::Sqrt(DistSq))
+		{
+			return;
+		}
+
+		OutActors.Add(Entry.Actor);
+	});
+
+	return OutActors.Num();
+}
+
+int32 UWSSpatialGridSubsystem::QuerySegment(FVector Start, FVector End, float Radius, EWSSpatialCategory Category, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reset();
+
+	const FLayer& Layer = GetLayer(Category);
+	const float RadiusSq = FMath::Square(Radius);
+
+	// Cover the segment with one square per cell-length chunk
+	const float Length = FVector::Dist(Start, End);
+	const int32 NumChunks = FMath::Max(1, FMath::CeilToInt(Length / CellSize));
+	const float HalfExtent = Length / (2.0f * NumChunks) + Radius;
+
+	TArray<int32, TInlineAllocator<64>> HitEntries;
+	for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+	{
+		const FVector ChunkCenter = FMath::Lerp(Start, End, (Chunk + 0.5f) / NumChunks);
+
+		ForEachEntryInSquare(Layer, ChunkCenter, HalfExtent, [&](int32 EntryIndex)
+		{
+			if (FMath::PointDistToSegmentSquared(Layer.Entries[EntryIndex].Location, Start, End) <= RadiusSq)
+			{
+				HitEntries.Add(EntryIndex);
+			}
+		});
+
+		// The brute-force path already visited everything
+		if (Layer.Entries.Num() <= BruteForceEntryLimit)
+		{
+			break;
+		}
+	}
+
+	// Neighbouring squares overlap, so an entry can be found more than once; sorting puts repeats side by side
+	if (NumChunks > 1)
+	{
+		HitEntries.Sort();
+	}
+
+	for (int32 i = 0; i < HitEntries.Num(); ++i)
+	{
+		if (i == 0 || HitEntries[i] != HitEntries[i - 1])
+		{
+			OutActors.Add(Layer.Entries[HitEntries[i]].Actor);
+		}
+	}
+
+	return OutActors.Num();
+}
+
+int32 UWSSpatialGridSubsystem::CountInRadius(FVector Location, float Radius, EWSSpatialCategory Category) const
+{
+	const FLayer& Layer = GetLayer(Category);
+	const float RadiusSq = FMath::Square(Radius);
+	int32 Count = 0;
+
+	ForEachEntryInSquare(Layer, Location, Radius, [&](int32 EntryIndex)
+	{
+		if (FVector::DistSquared(Location, Layer.Entries[EntryIndex].Location) <= RadiusSq)
+		{
+			Count++;
+		}
+	});
+
+	return Count;
+}
+
+int32 UWSSpatialGridSubsystem::QueryChain(AActor* FirstActor, EWSSpatialCategory Category, int32 MaxHops, float JumpRadius, TArray<AActor*>& OutChain) const
+{
+	OutChain.Reset();
+	if (!FirstActor)
+	{
+		return 0;
+	}
+
+	OutChain.Add(FirstActor);
+
+	// Every link already in the chain may be among the nearest, so ask for one more than the chain holds
+	TArray<AActor*> Nearby;
+	Nearby.Reserve(MaxHops + 1);
+
+	for (int32 Hop = 0; Hop < MaxHops; ++Hop)
+	{
+		FindNearestN(OutChain.Last()->GetActorLocation(), Category, OutChain.Num() + 1, Nearby, JumpRadius);
+
+		AActor* const* Next = Nearby.FindByPredicate([&OutChain](AActor* Candidate)
+		{
+			return !OutChain.Contains(Candidate);
+		});
+
+		if (!Next)
+		{
+			break;
+		}
+
+		OutChain.Add(*Next);
+	}
+
+	return OutChain.Num();
+}
+
+void UWSSpatialGridSubsystem::RunChainBenchmark(int32 NumChains, int32 MaxHops, float JumpRadius) const
+{
+	const FLayer& Layer = GetLayer(EWSSpatialCategory::Enemy);
+	if (Layer.Entries.Num() == 0 || NumChains <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Chain benchmark: no enemies registered"));
+		return;
+	}
+
+	// Same start enemies for both methods
+	TArray<int32> StartIndices;
+	for (int32 Chain = 0; Chain < NumChains; ++Chain)
+	{
+		StartIndices.Add(FMath::RandRange(0, Layer.Entries.Num() - 1));
+	}
+
+	TArray<AActor*> Links;
+	int32 GridLinks = 0;
+
+	const double GridStart = FPlatformTime::Seconds();
+	for (int32 StartIndex : StartIndices)
+	{
+		GridLinks += QueryChain(Layer.Entries[StartIndex].Actor, EWSSpatialCategory::Enemy, MaxHops, JumpRadius, Links);
+	}
+	const double GridSeconds = FPlatformTime::Seconds() - GridStart;
+
+	// Reference: scan every enemy on every hop
+	const float JumpRadiusSq = FMath::Square(JumpRadius);
+	TArray<int32> ChainIndices;
+	int32 ScanLinks = 0;
+
+	const double ScanStart = FPlatformTime::Seconds();
+	for (int32 StartIndex : StartIndices)
+	{
+		ChainIndices.Reset();
+		ChainIndices.Add(StartIndex);
+
+		for (int32 Hop = 0; Hop < MaxHops; ++Hop)
+		{
+			const FVector& From = Layer.Entries[ChainIndices.Last()].Location;
+			int32 BestIndex = INDEX_NONE;
+			float BestDistSq = JumpRadiusSq;
+
+			for (int32 EntryIndex = 0; EntryIndex < Layer.Entries.Num(); ++EntryIndex)
+			{
+				const float DistSq = FVector::DistSquared(From, Layer.Entries[EntryIndex].Location);
+				if (DistSq <= BestDistSq && !ChainIndices.Contains(EntryIndex))
+				{
+					BestDistSq = DistSq;
+					BestIndex = EntryIndex;
+				}
+			}
+
+			if (BestIndex == INDEX_NONE)
+			{
+				break;
+			}
+			ChainIndices.Add(BestIndex);
+		}
+
+		ScanLinks += ChainIndices.Num();
+	}
+	const double ScanSeconds = FPlatformTime::Seconds() - ScanStart;
+
+	UE_LOG(LogTemp, Log, TEXT("Chain benchmark (%d enemies, %d chains, %d hops, %.0f radius): grid %.2f us/chain (%.1f links), linear scan %.2f us/chain (%.1f links)"),
+		Layer.Entries.Num(), NumChains, MaxHops, JumpRadius,
+		GridSeconds * 1.0e6 / NumChains, (float)GridLinks / NumChains,
+		ScanSeconds * 1.0e6 / NumChains, (float)ScanLinks / NumChains);
+}
+
+int32 UWSSpatialGridSubsystem::GatherPackedPositions(const FVector& Location, float Radius, EWSSpatialCategory Category, TArray<float>& OutX, TArray<float>& OutY) const
+{
+	OutX.Reset();
+	OutY.Reset();
+
+	// Candidates from the overlapping cells; the caller's kernel does the exact distance test
+	const FLayer& Layer = GetLayer(Category);
+	ForEachEntryInSquare(Layer, Location, Radius, [&](int32 EntryIndex)
+	{
+		const FVector& EntryLocation = Layer.Entries[EntryIndex].Location;
+		OutX.Add(EntryLocation.X);
+		OutY.Add(EntryLocation.Y);
+	});
+
+	return OutX.Num();
+}
+
+int32 UWSSpatialGridSubsystem::GetRegisteredCount(EWSSpatialCategory Category) const
+{
+	return GetLayer(Category).Entries.Num();
+}
+
+FIntPoint UWSSpatialGridSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UWSSpatialGridSubsystem::AddToCell(FLayer& Layer, const FIntPoint& Cell, int32 EntryIndex)
+{
+	Layer.Cells.FindOrAdd(Cell).Add(EntryIndex);
+}
+
+void UWSSpatialGridSubsystem::RemoveFromCell(FLayer& Layer, const FIntPoint& Cell, int32 EntryIndex)
+{
+	TArray<int32>* CellEntries = Layer.Cells.Find(Cell);
+	if (CellEntries)
+	{
+		CellEntries->RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+	}
+}
+
+void UWSSpatialGridSubsystem::RefreshLayer(FLayer& Layer)
+{
+	if (Layer.Entries.Num() == 0)
+	{
+		return;
+	}
+
+	FIntPoint MinCell(MAX_int32, MAX_int32);
+	FIntPoint MaxCell(MIN_int32, MIN_int32);
+
+	for (int32 EntryIndex = 0; EntryIndex < Layer.Entries.Num(); ++EntryIndex)
+	{
+		FEntry& Entry = Layer.Entries[EntryIndex];
+		Entry.Location = Entry.Actor->GetActorLocation();
+
+		// Only touch the cell map when the entry crossed a cell boundary
+		const FIntPoint NewCell = GetCell(Entry.Location);
+		if (NewCell != Entry.Cell)
+		{
+			RemoveFromCell(Layer, Entry.Cell, EntryIndex);
+			AddToCell(Layer, NewCell, EntryIndex);
+			Entry.Cell = NewCell;
+		}
+
+		MinCell = FIntPoint(FMath::Min(MinCell.X, NewCell.X), FMath::Min(MinCell.Y, NewCell.Y));
+		MaxCell = FIntPoint(FMath::Max(MaxCell.X, NewCell.X), FMath::Max(MaxCell.Y, NewCell.Y));
+	}
+
+	Layer.MinCell = MinCell;
+	Layer.MaxCell = MaxCell;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs GWSChainBenchmarkCommand(
+	TEXT("ws.Spatial.ChainBenchmark"),
+	TEXT("Times chain hops through the live horde with the grid and with a linear scan. Run at different horde sizes to compare. Usage: ws.Spatial.ChainBenchmark [Chains=1000] [Hops=5] [JumpRadius=800]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const UWSSpatialGridSubsystem* SpatialGrid = World ? World->GetSubsystem<UWSSpatialGridSubsystem>() : nullptr;
+		if (SpatialGrid)
+		{
+			const int32 NumChains = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+			const int32 MaxHops = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 5;
+			const float JumpRadius = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 800.0f;
+			SpatialGrid->RunChainBenchmark(NumChains, MaxHops, JumpRadius);
+		}
+	}));
+#endif
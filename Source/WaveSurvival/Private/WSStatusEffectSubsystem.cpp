@@ -0,0 +1,246 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSStatusEffectSubsystem.h"
+#include "WaveSurvival.h"
+#include "WSEnemyBase.h"
+#include "WSEnemyManagerSubsystem.h"
+#include "WSDamageSubsystem.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Status Effect Step"), STAT_WSStatusEffectStep, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Status Effects"), STAT_WSActiveStatusEffects, STATGROUP_WaveSurvival);
+
+UWSStatusEffectSubsystem::UWSStatusEffectSubsystem()
+{
+	StepInterval = 0.25f;
+	MaxStepsPerFrame = 4;
+
+	// Indexed by EWSElementalType; electric chains at hit time instead
+	EffectSettings.Add(FWSStatusEffectSettings());
+	EffectSettings.Add(FWSStatusEffectSettings(3.0f, 10.0f, true, 5));	// Fire: burn DPS
+	EffectSettings.Add(FWSStatusEffectSettings(2.0f, 0.15f, true, 4));	// Ice: slow fraction
+	EffectSettings.Add(FWSStatusEffectSettings(4.0f, 0.1f, true, 5));	// Acid: armor shred
+	EffectSettings.Add(FWSStatusEffectSettings());
+	EffectSettings.Add(FWSStatusEffectSettings(5.0f, 6.0f, true, 10));	// Poison: DPS
+
+	StepAccumulator = 0.0f;
+	LastStepMilliseconds = 0.0f;
+}
+
+bool UWSStatusEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWSStatusEffectSubsystem::Deinitialize()
+{
+	for (FEffectBatch& Batch : Batches)
+	{
+		Batch = FEffectBatch();
+	}
+
+	Super::Deinitialize();
+}
+
+void UWSStatusEffectSubsystem::Tick(float DeltaTime)
+{
+	StepAccumulator += DeltaTime;
+
+	int32 NumSteps = 0;
+	while (StepAccumulator >= StepInterval && NumSteps < MaxStepsPerFrame)
+	{
+		Step(StepInterval);
+		StepAccumulator -= StepInterval;
+		NumSteps++;
+	}
+
+	// Drop whatever is left after a long hitch rather than spiral
+	if (NumSteps == MaxStepsPerFrame)
+	{
+		StepAccumulator = FMath::Min(StepAccumulator, StepInterval);
+	}
+
+	SET_DWORD_STAT(STAT_WSActiveStatusEffects, GetTotalActiveEffectCount());
+}
+
+TStatId UWSStatusEffectSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWSStatusEffectSubsystem, STATGROUP_Tickables);
+}
+
+bool UWSStatusEffectSubsystem::ApplyEffect(const FWSEnemyHandle& Target, EWSElementalType Element, int32 InstigatorSlot)
+{
+	const int32 ElementIndex = (int32)Element;
+	if (!Target.IsSet() || !EffectSettings.IsValidIndex(ElementIndex) || EffectSettings[ElementIndex].Duration <= 0.0f)
+	{
+		return false;
+	}
+
+	const FWSStatusEffectSettings& Settings = EffectSettings[ElementIndex];
+	FEffectBatch& Batch = Batches[ElementIndex];
+
+	int32 Index;
+	if (const int32* ExistingIndex = Batch.Indices.Find(Target))
+	{
+		// Merge into the existing effect: refresh the duration and add a stack if allowed
+		Index = *ExistingIndex;
+		Batch.RemainingTimes[Index] = Settings.Duration;
+		Batch.InstigatorSlots[Index] = InstigatorSlot;
+
+		if (!Settings.bStackable || Batch.Stacks[Index] >= Settings.MaxStacks)
+		{
+			return true;
+		}
+		Batch.Stacks[Index]++;
+	}
+	else
+	{
+		Index = Batch.Num();
+		Batch.Targets.Add(Target);
+		Batch.RemainingTimes.Add(Settings.Duration);
+		Batch.Stacks.Add(1);
+		Batch.Intensities.Add(0.0f);
+		Batch.InstigatorSlots.Add(InstigatorSlot);
+		Batch.Indices.Add(Target, Index);
+	}
+
+	Batch.Intensities[Index] = Settings.MagnitudePerStack * Batch.Stacks[Index];
+	ApplyModifier(Target, Element, Batch.Intensities[Index]);
+
+	return true;
+}
+
+int32 UWSStatusEffectSubsystem::GetActiveEffectCount(EWSElementalType Element) const
+{
+	return Batches[(int32)Element].Num();
+}
+
+int32 UWSStatusEffectSubsystem::GetTotalActiveEffectCount() const
+{
+	int32 Total = 0;
+	for (const FEffectBatch& Batch : Batches)
+	{
+		Total += Batch.Num();
+	}
+	return Total;
+}
+
+float UWSStatusEffectSubsystem::GetLastStepMilliseconds() const
+{
+	return LastStepMilliseconds;
+}
+
+void UWSStatusEffectSubsystem::Step(float StepTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSStatusEffectStep);
+	const double StartTime = FPlatformTime::Seconds();
+
+	const UWSEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UWSEnemyManagerSubsystem>();
+	UWSDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UWSDamageSubsystem>();
+
+	for (int32 ElementIndex = 0; ElementIndex < NumElements; ++ElementIndex)
+	{
+		FEffectBatch& Batch = Batches[ElementIndex];
+		const int32 Count = Batch.Num();
+		if (Count == 0)
+		{
+			continue;
+		}
+
+		const EWSElementalType Element = (EWSElementalType)ElementIndex;
+		const bool bDamageOverTime = IsDamageOverTime(Element);
+
+		// Flat passes over contiguous floats so the compiler can vectorize them
+		float* RemainingTimes = Batch.RemainingTimes.GetData();
+		for (int32 i = 0; i < Count; ++i)
+		{
+			RemainingTimes[i] -= StepTime;
+		}
+
+		if (bDamageOverTime)
+		{
+			StepDamages.SetNumUninitialized(Count, EAllowShrinking::No);
+			const float* Intensities = Batch.Intensities.GetData();
+			float* Damages = StepDamages.GetData();
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Damages[i] = Intensities[i] * StepTime;
+			}
+		}
+
+		// Iterate backwards so swap-removal doesn't skip anything
+		for (int32 i = Count - 1; i >= 0; --i)
+		{
+			if (!EnemyManager || !EnemyManager->IsValidHandle(Batch.Targets[i]))
+			{
+				RemoveEffect(Batch, i);
+				continue;
+			}
+
+			// Ticks carry no element so they don't re-apply the effect that caused them
+			if (bDamageOverTime && DamageSubsystem)
+			{
+				FWSDamageEvent Event;
+				Event.Target = Batch.Targets[i];
+				Event.Amount = StepDamages[i];
+				Event.InstigatorSlot = Batch.InstigatorSlots[i];
+				DamageSubsystem->QueueDamage(Event);
+			}
+
+			if (RemainingTimes[i] <= 0.0f)
+			{
+				ApplyModifier(Batch.Targets[i], Element, 0.0f);
+				RemoveEffect(Batch, i);
+			}
+		}
+	}
+
+	LastStepMilliseconds = (float)((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void UWSStatusEffectSubsystem::RemoveEffect(FEffectBatch& Batch, int32 Index)
+{
+	Batch.Indices.Remove(Batch.Targets[Index]);
+
+	// Patch the index of the element moved into the hole
+	const int32 LastIndex = Batch.Num() - 1;
+	if (Index != LastIndex)
+	{
+		Batch.Indices[Batch.Targets[LastIndex]] = Index;
+	}
+
+	Batch.Targets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Batch.RemainingTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Batch.Stacks.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Batch.Intensities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Batch.InstigatorSlots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UWSStatusEffectSubsystem::ApplyModifier(const FWSEnemyHandle& Target, EWSElementalType Element, float Intensity) const
+{
+	if (Element != EWSElementalType::Ice && Element != EWSElementalType::Acid)
+	{
+		return;
+	}
+
+	const UWSEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UWSEnemyManagerSubsystem>();
+	AWSEnemyBase* Enemy = EnemyManager ? EnemyManager->GetEnemy(Target) : nullptr;
+	if (!Enemy)
+	{
+		return;
+	}
+
+	if (Element == EWSElementalType::Ice)
+	{
+		Enemy->SetSlowFraction(Intensity);
+	}
+	else
+	{
+		Enemy->SetArmorShred(Intensity);
+	}
+}
+
+bool UWSStatusEffectSubsystem::IsDamageOverTime(EWSElementalType Element)
+{
+	return Element == EWSElementalType::Fire || Element == EWSElementalType::Poison;
+}
@@ -3,14 +3,46 @@
 #include "WSWeaponBase.h"
 #include "WSPlayerState.h"
 #include "WSEnemyBase.h"
+#include "WSHitscanSubsystem.h"
+#include "WSHitboxSubsystem.h"
+#include "WSLagCompensationSubsystem.h"
+#include "WSDamageSubsystem.h"
+#include "WSProjectileSubsystem.h"
+#include "WSSpatialGridSubsystem.h"
 #include "DrawDebugHelpers.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/GameStateBase.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+#if ENABLE_DRAW_DEBUG
+	TAutoConsoleVariable<bool> CVarDrawShots(
+		TEXT("ws.Weapon.DrawShots"),
+		false,
+		TEXT("Draws a debug line for every shot, pellet, piercing ray and chain link."));
+#endif
+
+	void DrawShotLine(const UWorld* World, const FVector& Start, const FVector& End, const FColor& Color)
+	{
+#if ENABLE_DRAW_DEBUG
+		if (CVarDrawShots.GetValueOnGameThread())
+		{
+			DrawDebugLine(World, Start, End, Color, false, 1.0f, 0, 1.0f);
+		}
+#endif
+	}
+}
 
 AWSWeaponBase::AWSWeaponBase()
 {
 	PrimaryActorTick.bCanEverTick = true;
 
+	// Spawned by the server; replicated movement carries the attachment to the owner's mesh
+	bReplicates = true;
+	SetReplicatingMovement(true);
+
 	// Create weapon mesh
 	WeaponMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("WeaponMesh"));
 	RootComponent = WeaponMesh;
@@ -24,6 +56,30 @@ AWSWeaponBase::AWSWeaponBase()
 	ReloadTime = 2.0f;
 	Range = 5000.0f;
 	bAutomatic = true;
+	bPreciseHitscan = false;
+
+	PelletCount = 8;
+	PelletSpreadAngle = 6.0f;
+	FalloffStartRange = 500.0f;
+	FalloffEndRange = 2000.0f;
+	MinFalloffMultiplier = 0.3f;
+
+	ProjectileSpeed = 6000.0f;
+	ProjectileRadius = 10.0f;
+
+	MeleeHalfAngle = 60.0f;
+	MaxMeleeTargets = 8;
+	MaxChainHops = 4;
+	ChainJumpRadius = 800.0f;
+	ChainDamageFalloff = 0.7f;
+	PenetrationBudget = 3.0f;
+	PierceDamageFalloff = 0.75f;
+	HeadshotMultiplier = 2.0f;
+	LimbMultiplier = 0.75f;
+	bAllShotsHeadshots = false;
+	AckInterval = 0.1f;
+	ReloadGraceTime = 0.15f;
+	FireRateTolerance = 0.2f;
 
 	CurrentAmmo = MagazineSize;
 	ElementalType = EWSElementalType::None;
@@ -32,6 +88,18 @@ AWSWeaponBase::AWSWeaponBase()
 	bIsFiring = false;
 	bIsReloading = false;
 	TimeSinceLastShot = 0.0f;
+	ShotAccumulator = 0.0f;
+	ShotTimestamp = -1.0;
+	ShotAimDirection = FVector::ZeroVector;
+	ReloadCount = 0;
+	NextShotSequence = 1;
+	PendingFirstSequence = 0;
+	PendingShotCount = 0;
+	LastServerSequence = 0;
+	LastAcceptedShotTime = 0.0;
+	bAckPending = false;
+	TimeSinceAck = 0.0f;
+	bStatSnapshotValid = false;
 }
 
 void AWSWeaponBase::BeginPlay()
@@ -43,29 +111,130 @@ void AWSWeaponBase::BeginPlay()
 	UE_LOG(LogTemp, Log, TEXT("Weapon initialized: %d"), (int32)WeaponType);
 }
 
+void AWSWeaponBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnbindStatSnapshot();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AWSWeaponBase::SetOwner(AActor* NewOwner)
+{
+	if (NewOwner != GetOwner())
+	{
+		InvalidateStatSnapshot();
+	}
+
+	Super::SetOwner(NewOwner);
+}
+
+void AWSWeaponBase::InvalidateStatSnapshot()
+{
+	bStatSnapshotValid = false;
+}
+
+const FWSWeaponStatSnapshot& AWSWeaponBase::GetStatSnapshot()
+{
+	if (!bStatSnapshotValid)
+	{
+		RefreshStatSnapshot();
+	}
+
+	return StatSnapshot;
+}
+
+void AWSWeaponBase::RefreshStatSnapshot()
+{
+	StatSnapshot = FWSWeaponStatSnapshot();
+
+	if (ElementalType != EWSElementalType::None)
+	{
+		StatSnapshot.ElementalDamagePercent = ElementalDamagePercent;
+	}
+
+	const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+	AWSPlayerState* PS = OwnerPawn ? OwnerPawn->GetPlayerState<AWSPlayerState>() : nullptr;
+
+	if (PS != SnapshotPlayerState.Get())
+	{
+		UnbindStatSnapshot();
+		if (PS)
+		{
+			StatsChangedHandle = PS->OnCombatStatsChanged.AddUObject(this, &AWSWeaponBase::InvalidateStatSnapshot);
+			SnapshotPlayerState = PS;
+		}
+	}
+
+	// Without a player state yet (e.g. before possession) use neutral stats and try again next shot
+	if (!PS)
+	{
+		return;
+	}
+
+	StatSnapshot.DamageMultiplier = PS->PlayerStats.DamageMultiplier;
+	StatSnapshot.CriticalChance = PS->PlayerStats.CriticalChance;
+	StatSnapshot.CriticalDamageMultiplier = PS->PlayerStats.CriticalDamageMultiplier;
+	StatSnapshot.ReloadSpeed = PS->PlayerStats.ReloadSpeed;
+	StatSnapshot.PlayerSlot = PS->PlayerSlot;
+	bStatSnapshotValid = true;
+}
+
+void AWSWeaponBase::UnbindStatSnapshot()
+{
+	AWSPlayerState* PS = SnapshotPlayerState.Get();
+	if (PS)
+	{
+		PS->OnCombatStatsChanged.Remove(StatsChangedHandle);
+	}
+
+	StatsChangedHandle.Reset();
+	SnapshotPlayerState.Reset();
+}
+
 void AWSWeaponBase::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
 	TimeSinceLastShot += DeltaTime;
 
-	// Automatic fire
+	// Automatic fire: emit every shot owed this frame so the fire rate doesn't depend on frame rate.
+	// Hitscan shots fired here all land in the same async trace batch.
 	if (bIsFiring && bAutomatic && CanFire())
 	{
-		if (TimeSinceLastShot >= FireRate)
+		const int32 ShotsOwed = ConsumeShotsOwed(ShotAccumulator, DeltaTime, FireRate, CurrentAmmo);
+		for (int32 Shot = 0; Shot < ShotsOwed && CanFire(); ++Shot)
 		{
 			Fire();
 		}
 	}
+	else
+	{
+		// Start the cadence fresh after a reload or trigger release
+		ShotAccumulator = 0.0f;
+	}
+
+	// Everything predicted this frame goes to the server in one call
+	FlushPredictedShots();
+
+	if (bAckPending)
+	{
+		TimeSinceAck += DeltaTime;
+		if (TimeSinceAck >= AckInterval)
+		{
+			SendAck();
+		}
+	}
 }
 
 void AWSWeaponBase::StartFire()
 {
 	bIsFiring = true;
+	ShotAccumulator = 0.0f;
 
 	if (CanFire())
 	{
 		Fire();
+		FlushPredictedShots();
 	}
 	else if (NeedsReload())
 	{
@@ -87,21 +256,53 @@ void AWSWeaponBase::Fire()
 
 	CurrentAmmo--;
 	TimeSinceLastShot = 0.0f;
+	OnFireEffects();
 
-	// Perform attack based on fire mode
-	switch (FireMode)
+	// Clients only spend the ammo and show the shot; hits are resolved when the server replays it
+	if (IsPredictingClient())
 	{
-		case EWSWeaponFireMode::Hitscan:
-			PerformHitscan();
-			break;
-			
-		case EWSWeaponFireMode::Projectile:
+		if (PendingShotCount == 0)
+		{
+			PendingFirstSequence = NextShotSequence;
+		}
+		NextShotSequence++;
+		PendingShotCount++;
+
+		if (PendingShotCount == MAX_uint8)
+		{
+			FlushPredictedShots();
+		}
+
+		// The owner sees its projectiles fly now rather than never; they are the server's to land
+		if (FireMode == EWSWeaponFireMode::Projectile)
+		{
 			PerformProjectile();
-			break;
+		}
+	}
+	else
+	{
+		switch (FireMode)
+		{
+			case EWSWeaponFireMode::Hitscan:
+				PerformHitscan();
+				break;
 			
-		case EWSWeaponFireMode::Melee:
-			PerformMelee();
-			break;
+			case EWSWeaponFireMode::Projectile:
+				PerformProjectile();
+				break;
+			
+			case EWSWeaponFireMode::Melee:
+				PerformMelee();
+				break;
+
+			case EWSWeaponFireMode::PelletSpread:
+				PerformPelletSpread();
+				break;
+
+			case EWSWeaponFireMode::Piercing:
+				PerformPiercing();
+				break;
+		}
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("Weapon fired - Ammo remaining: %d/%d"), CurrentAmmo, MagazineSize);
@@ -113,6 +314,17 @@ void AWSWeaponBase::Fire()
 	}
 }
 
+void AWSWeaponBase::FireAtTime(double ClientTimestamp, const FVector& AimDirection)
+{
+	// Clients can't ask for more rewind than the server keeps
+	const UWSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UWSLagCompensationSubsystem>();
+	const bool bRewind = LagCompensation && ClientTimestamp >= 0.0;
+	TGuardValue<double> TimestampGuard(ShotTimestamp, bRewind ? LagCompensation->ClampRewindTimestamp(ClientTimestamp) : -1.0);
+	TGuardValue<FVector> AimGuard(ShotAimDirection, AimDirection.GetSafeNormal());
+
+	Fire();
+}
+
 void AWSWeaponBase::Reload()
 {
 	if (bIsReloading || CurrentAmmo == MagazineSize)
@@ -120,24 +332,202 @@ void AWSWeaponBase::Reload()
 		return;
 	}
 
+	// Shots fired before the reload must reach the server first
+	if (IsPredictingClient())
+	{
+		FlushPredictedShots();
+		ServerReload();
+	}
+
+	StartReload();
+}
+
+void AWSWeaponBase::StartReload()
+{
 	bIsReloading = true;
+	ReloadCount++;
 
 	// Get reload time with player stat modifiers
-	float ActualReloadTime = ReloadTime;
+	const float ActualReloadTime = ReloadTime * (1.0f / GetStatSnapshot().ReloadSpeed);
+
+	GetWorld()->GetTimerManager().SetTimer(ReloadTimerHandle, this, &AWSWeaponBase::FinishReload, ActualReloadTime, false);
 	
-	ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner());
-	if (OwnerCharacter)
+	UE_LOG(LogTemp, Log, TEXT("Reloading weapon - Time: %f seconds"), ActualReloadTime);
+}
+
+bool AWSWeaponBase::IsPredictingClient() const
+{
+	return GetLocalRole() < ROLE_Authority;
+}
+
+void AWSWeaponBase::FlushPredictedShots()
+{
+	if (!IsPredictingClient() || PendingShotCount == 0)
 	{
-		AWSPlayerState* PS = Cast<AWSPlayerState>(OwnerCharacter->GetPlayerState());
-		if (PS)
+		return;
+	}
+
+	FVector TraceStart;
+	FVector TraceEnd;
+	const FVector AimDirection = GetHitscanRay(TraceStart, TraceEnd) ? (TraceEnd - TraceStart).GetSafeNormal() : FVector::ZeroVector;
+
+	// Server time as this client sees it, so the server can rewind enemies to what was on screen
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const double ClientTimestamp = GameState ? GameState->GetServerWorldTimeSeconds() : -1.0;
+
+	ServerFireShots(PendingFirstSequence, PendingShotCount, ReloadCount, ClientTimestamp, AimDirection);
+	PendingShotCount = 0;
+}
+
+void AWSWeaponBase::ServerFireShots_Implementation(uint16 FirstSequence, uint8 ShotCount, uint8 ClientReloadCount, double ClientTimestamp, FVector_NetQuantizeNormal AimDirection)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	bool bRejected = false;
+	for (int32 i = 0; i < ShotCount; ++i)
+	{
+		// The client's reload may finish a moment before ours; don't drop shots over timer jitter. Shots
+		// the client fired before starting this reload are just rejected, as they would have been locally.
+		if (bIsReloading && ClientReloadCount == ReloadCount
+			&& GetWorld()->GetTimerManager().GetTimerRemaining(ReloadTimerHandle) <= ReloadGraceTime)
 		{
-			ActualReloadTime *= (1.0f / PS->PlayerStats.ReloadSpeed);
+			GetWorld()->GetTimerManager().ClearTimer(ReloadTimerHandle);
+			FinishReload();
+		}
+
+		// Without an interval the client fires at most once per frame, and sends each frame's shots as one batch
+		const bool bWithinFireRate = FireRate > 0.0f
+			? ConsumeFireRateBudget(LastAcceptedShotTime, Now, FireRate, FireRateTolerance)
+			: i == 0;
+
+		if (bWithinFireRate && CanFire())
+		{
+			FireAtTime(ClientTimestamp, AimDirection);
+		}
+		else
+		{
+			bRejected = true;
 		}
 	}
 
-	GetWorld()->GetTimerManager().SetTimer(ReloadTimerHandle, this, &AWSWeaponBase::FinishReload, ActualReloadTime, false);
-	
-	UE_LOG(LogTemp, Log, TEXT("Reloading weapon - Time: %f seconds"), ActualReloadTime);
+	LastServerSequence = FirstSequence + ShotCount - 1;
+	bAckPending = true;
+
+	// The client spent ammo it doesn't have; correct it now rather than at the next ack
+	if (bRejected)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("Rejected predicted shots up to %d"), LastServerSequence);
+		SendAck();
+	}
+}
+
+void AWSWeaponBase::ServerReload_Implementation()
+{
+	Reload();
+	bAckPending = true;
+}
+
+void AWSWeaponBase::SendAck()
+{
+	FWSWeaponAck Ack;
+	Ack.ShotSequence = LastServerSequence;
+	Ack.Ammo = (uint16)FMath::Clamp(CurrentAmmo, 0, (int32)MAX_uint16);
+	Ack.ReloadCount = ReloadCount;
+	Ack.bIsReloading = bIsReloading;
+
+	ClientAckShots(Ack);
+
+	bAckPending = false;
+	TimeSinceAck = 0.0f;
+}
+
+void AWSWeaponBase::ClientAckShots_Implementation(FWSWeaponAck Ack)
+{
+	const int8 ReloadDelta = GetReloadDelta(Ack.ReloadCount, ReloadCount);
+	if (ReloadDelta < 0)
+	{
+		// Sent before a reload this client already started
+		return;
+	}
+
+	if (ReloadDelta > 0)
+	{
+		// The server reloaded without us asking, e.g. on an empty magazine we thought had rounds left
+		if (Ack.bIsReloading && !bIsReloading)
+		{
+			StartReload();
+		}
+		ReloadCount = Ack.ReloadCount;
+	}
+
+	// Ammo is refilled when the local reload finishes
+	if (bIsReloading || Ack.bIsReloading)
+	{
+		return;
+	}
+
+	const int32 CorrectedAmmo = GetCorrectedAmmo(Ack.Ammo, Ack.ShotSequence, NextShotSequence);
+	if (CorrectedAmmo != CurrentAmmo)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("Weapon ammo corrected by server: %d -> %d"), CurrentAmmo, CorrectedAmmo);
+		CurrentAmmo = CorrectedAmmo;
+	}
+}
+
+int32 AWSWeaponBase::GetCorrectedAmmo(uint16 AckedAmmo, uint16 AckedSequence, uint16 NextSequence)
+{
+	// Shots fired since the acked one are still in flight and already paid for locally
+	const uint16 UnackedShots = (uint16)(NextSequence - 1 - AckedSequence);
+	return FMath::Max((int32)AckedAmmo - (int32)UnackedShots, 0);
+}
+
+int8 AWSWeaponBase::GetReloadDelta(uint8 AckReloadCount, uint8 LocalReloadCount)
+{
+	// Counts wrap, so compare as signed deltas
+	return (int8)(uint8)(AckReloadCount - LocalReloadCount);
+}
+
+int32 AWSWeaponBase::ConsumeShotsOwed(float& Accumulator, float DeltaTime, float FireInterval, int32 MaxShots)
+{
+	if (MaxShots <= 0)
+	{
+		return 0;
+	}
+
+	// No interval set: one shot per frame
+	if (FireInterval <= 0.0f)
+	{
+		Accumulator = 0.0f;
+		return 1;
+	}
+
+	Accumulator += DeltaTime;
+
+	const int32 ShotsOwed = FMath::Min(FMath::FloorToInt(Accumulator / FireInterval), MaxShots);
+	Accumulator -= ShotsOwed * FireInterval;
+
+	// Don't bank a backlog the magazine couldn't pay out
+	if (ShotsOwed == MaxShots)
+	{
+		Accumulator = FMath::Min(Accumulator, FireInterval);
+	}
+
+	return ShotsOwed;
+}
+
+bool AWSWeaponBase::ConsumeFireRateBudget(double& ShotClock, double Now, float FireInterval, float Tolerance)
+{
+	// Time not spent firing banks at most Tolerance worth of shots
+	ShotClock = FMath::Max(ShotClock, Now - Tolerance);
+
+	// Shots owed since the last accepted one, plus one for jitter
+	if (ShotClock > Now)
+	{
+		return false;
+	}
+
+	ShotClock += FireInterval;
+	return true;
 }
 
 bool AWSWeaponBase::CanFire() const
@@ -152,33 +542,68 @@ bool AWSWeaponBase::NeedsReload() const
 
 void AWSWeaponBase::PerformHitscan()
 {
-	ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner());
-	if (!OwnerCharacter)
+	FVector TraceStart;
+	FVector TraceEnd;
+	if (!GetHitscanRay(TraceStart, TraceEnd))
 	{
 		return;
 	}
 
+	// Automatic weapons queue their shots as async traces resolved next frame
+	UWSHitscanSubsystem* HitscanSubsystem = GetWorld()->GetSubsystem<UWSHitscanSubsystem>();
+	if (!bPreciseHitscan && HitscanSubsystem)
+	{
+		HitscanSubsystem->QueueShot(this, TraceStart, TraceEnd);
+		return;
+	}
+
+	FHitResult HitResult;
+	const bool bHit = TraceShot(TraceStart, TraceEnd, HitResult);
+
+	ApplyHitscanResult(bHit, HitResult, TraceStart, TraceEnd);
+}
+
+bool AWSWeaponBase::GetHitscanRay(FVector& OutStart, FVector& OutEnd) const
+{
+	const AActor* OwnerActor = GetOwner();
+	if (!OwnerActor)
+	{
+		return false;
+	}
+
 	// Get camera location and direction
 	FVector CameraLocation;
 	FRotator CameraRotation;
-	OwnerCharacter->GetActorEyesViewPoint(CameraLocation, CameraRotation);
+	OwnerActor->GetActorEyesViewPoint(CameraLocation, CameraRotation);
 
-	FVector TraceStart = CameraLocation;
-	FVector TraceEnd = TraceStart + (CameraRotation.Vector() * Range);
+	// Shots replayed for a remote owner use the aim it fired with
+	const FVector AimDirection = ShotAimDirection.IsZero() ? CameraRotation.Vector() : ShotAimDirection;
 
-	// Perform line trace
-	FHitResult HitResult;
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(OwnerCharacter);
+	OutStart = CameraLocation;
+	OutEnd = OutStart + (AimDirection * Range);
+	return true;
+}
+
+bool AWSWeaponBase::TraceShot(const FVector& TraceStart, const FVector& TraceEnd, FHitResult& OutHit) const
+{
+	UWSHitboxSubsystem* HitboxSubsystem = GetWorld()->GetSubsystem<UWSHitboxSubsystem>();
+	return HitboxSubsystem && HitboxSubsystem->TraceHitscan(TraceStart, TraceEnd, GetHitscanQueryParams(), OutHit, ShotTimestamp);
+}
+
+FCollisionQueryParams AWSWeaponBase::GetHitscanQueryParams() const
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WSHitscan));
+	QueryParams.AddIgnoredActor(GetOwner());
 	QueryParams.AddIgnoredActor(this);
+	return QueryParams;
+}
 
-	bool bHit = GetWorld()->LineTraceSingleByChannel(
-		HitResult,
-		TraceStart,
-		TraceEnd,
-		ECC_Visibility,
-		QueryParams
-	);
+void AWSWeaponBase::ApplyHitscanResult(bool bHit, const FHitResult& HitResult, const FVector& TraceStart, const FVector& TraceEnd)
+{
+	if (!GetOwner())
+	{
+		return;
+	}
 
 	if (bHit)
 	{
@@ -186,51 +611,285 @@ void AWSWeaponBase::PerformHitscan()
 		AWSEnemyBase* Enemy = Cast<AWSEnemyBase>(HitResult.GetActor());
 		if (Enemy)
 		{
-			bool bIsCritical = false;
-			float Damage = CalculateDamage(bIsCritical);
-			
-			// Apply damage and check if it killed the enemy
-			// Note: In multiplayer, concurrent damage from multiple players may still cause
-			// race conditions. For production, implement server-authoritative kill tracking.
-			bool bKilledEnemy = Enemy->TakeDamageCustom(Damage, OwnerCharacter, bIsCritical);
-			
-			// Apply elemental effect
-			if (ElementalType != EWSElementalType::None)
-			{
-				ApplyElementalEffect(Enemy);
-			}
-
-			// Award kill credit based on the actual result from TakeDamageCustom
-			if (bKilledEnemy)
-			{
-				AWSPlayerState* PS = Cast<AWSPlayerState>(OwnerCharacter->GetPlayerState());
-				if (PS)
-				{
-					PS->OnKill();
-				}
-			}
+			DamageEnemy(Enemy, GetRegionMultiplier(HitResult));
 		}
 
-		// Debug draw
-		DrawDebugLine(GetWorld(), TraceStart, HitResult.Location, FColor::Red, false, 1.0f, 0, 1.0f);
+		DrawShotLine(GetWorld(), TraceStart, HitResult.Location, FColor::Red);
+	}
+	else
+	{
+		DrawShotLine(GetWorld(), TraceStart, TraceEnd, FColor::White);
+	}
+}
+
+void AWSWeaponBase::PerformPelletSpread()
+{
+	FVector TraceStart;
+	FVector AimEnd;
+	if (!GetHitscanRay(TraceStart, AimEnd) || PelletCount <= 0)
+	{
+		return;
+	}
+
+	const FVector AimDirection = (AimEnd - TraceStart).GetSafeNormal();
+	const float SpreadRadians = FMath::DegreesToRadians(PelletSpreadAngle);
+
+	TArray<FVector> PelletEnds;
+	PelletEnds.Reserve(PelletCount);
+	for (int32 Pellet = 0; Pellet < PelletCount; ++Pellet)
+	{
+		PelletEnds.Add(TraceStart + FMath::VRandCone(AimDirection, SpreadRadians) * Range);
+	}
+
+	// All pellets go out as one batch and are applied together next frame
+	UWSHitscanSubsystem* HitscanSubsystem = GetWorld()->GetSubsystem<UWSHitscanSubsystem>();
+	if (!bPreciseHitscan && HitscanSubsystem)
+	{
+		HitscanSubsystem->QueueShotBatch(this, TraceStart, PelletEnds);
+		return;
+	}
+
+	TArray<FHitResult> PelletHits;
+	PelletHits.SetNum(PelletEnds.Num());
+	if (UWSHitboxSubsystem* HitboxSubsystem = GetWorld()->GetSubsystem<UWSHitboxSubsystem>())
+	{
+		HitboxSubsystem->TraceHitscanBatch(TraceStart, PelletEnds, GetHitscanQueryParams(), PelletHits, ShotTimestamp);
+	}
+	PelletHits.RemoveAllSwap([](const FHitResult& Hit) { return !Hit.bBlockingHit; }, EAllowShrinking::No);
+
+	ApplyPelletResults(PelletHits, TraceStart);
+}
+
+void AWSWeaponBase::ApplyPelletResults(const TArray<FHitResult>& PelletHits, const FVector& TraceStart)
+{
+	if (!GetOwner())
+	{
+		return;
+	}
+
+	// Sum the falloff-scaled share of every pellet per enemy
+	TArray<TPair<AWSEnemyBase*, float>, TInlineAllocator<16>> EnemyHits;
+	for (const FHitResult& HitResult : PelletHits)
+	{
+		DrawShotLine(GetWorld(), TraceStart, HitResult.Location, FColor::Orange);
+
+		AWSEnemyBase* Enemy = Cast<AWSEnemyBase>(HitResult.GetActor());
+		if (!Enemy || Enemy->IsPooled())
+		{
+			continue;
+		}
+
+		const float PelletShare = GetFalloffMultiplier(HitResult.Distance) * GetRegionMultiplier(HitResult) / PelletCount;
+
+		TPair<AWSEnemyBase*, float>* Existing = EnemyHits.FindByPredicate([Enemy](const TPair<AWSEnemyBase*, float>& Entry)
+		{
+			return Entry.Key == Enemy;
+		});
+
+		if (Existing)
+		{
+			Existing->Value += PelletShare;
+		}
+		else
+		{
+			EnemyHits.Emplace(Enemy, PelletShare);
+		}
+	}
+
+	// One damage application, health bar update and kill check per enemy, in order of first pellet hit.
+	// Only the first enemy hit starts a chain.
+	for (int32 i = 0; i < EnemyHits.Num(); ++i)
+	{
+		DamageEnemy(EnemyHits[i].Key, EnemyHits[i].Value, i == 0);
+	}
+}
+
+void AWSWeaponBase::PerformPiercing()
+{
+	FVector TraceStart;
+	FVector TraceEnd;
+	UWSHitboxSubsystem* HitboxSubsystem = GetWorld()->GetSubsystem<UWSHitboxSubsystem>();
+	if (!HitboxSubsystem || !GetHitscanRay(TraceStart, TraceEnd))
+	{
+		return;
+	}
+
+	// One occlusion trace and one hitbox query return every enemy in line, nearest first
+	FHitResult WorldHit;
+	HitboxSubsystem->TraceHitscanMulti(TraceStart, TraceEnd, GetHitscanQueryParams(), PierceHits, WorldHit, ShotTimestamp);
+
+	FVector ShotEnd = WorldHit.bBlockingHit ? WorldHit.Location : TraceEnd;
+	float RemainingBudget = PenetrationBudget;
+	float PierceScale = 1.0f;
+	bool bHitEnemy = false;
+
+	// Every pierced enemy is queued this frame, so the damage subsystem resolves them together with the
+	// rest of the frame's hits and does the kill bookkeeping once
+	for (const FHitResult& HitResult : PierceHits)
+	{
+		AWSEnemyBase* Enemy = Cast<AWSEnemyBase>(HitResult.GetActor());
+		if (!Enemy || Enemy->IsPooled())
+		{
+			continue;
+		}
+
+		DamageSingleEnemy(Enemy, PierceScale * GetRegionMultiplier(HitResult));
+		bHitEnemy = true;
+
+		// The shot stops inside the enemy that exhausts its budget
+		RemainingBudget -= Enemy->PenetrationResistance;
+		if (RemainingBudget <= 0.0f)
+		{
+			ShotEnd = HitResult.Location;
+			break;
+		}
+		PierceScale *= PierceDamageFalloff;
+	}
+
+	DrawShotLine(GetWorld(), TraceStart, ShotEnd, bHitEnemy ? FColor::Magenta : FColor::White);
+}
+
+void AWSWeaponBase::DamageEnemy(AWSEnemyBase* Enemy, float DamageScale, bool bCanChain)
+{
+	if (bCanChain && ChainsDamage())
+	{
+		DamageChain(Enemy, DamageScale);
 	}
 	else
 	{
-		// Debug draw
-		DrawDebugLine(GetWorld(), TraceStart, TraceEnd, FColor::White, false, 1.0f, 0, 1.0f);
+		DamageSingleEnemy(Enemy, DamageScale);
+	}
+}
+
+bool AWSWeaponBase::ChainsDamage() const
+{
+	return MaxChainHops > 0 && (WeaponType == EWSWeaponType::LightningGun || ElementalType == EWSElementalType::Electric);
+}
+
+void AWSWeaponBase::DamageChain(AWSEnemyBase* FirstEnemy, float DamageScale)
+{
+	UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (!SpatialGrid || !FirstEnemy || FirstEnemy->IsPooled())
+	{
+		DamageSingleEnemy(FirstEnemy, DamageScale);
+		return;
+	}
+
+	// Each hop is one bounded nearest-neighbour query on the grid
+	SpatialGrid->QueryChain(FirstEnemy, EWSSpatialCategory::Enemy, MaxChainHops, ChainJumpRadius, ChainLinks);
+
+	// Every link is queued this frame, so the damage subsystem resolves the whole chain together
+	float LinkScale = DamageScale;
+	for (int32 Link = 0; Link < ChainLinks.Num(); ++Link)
+	{
+		if (Link > 0)
+		{
+			DrawShotLine(GetWorld(), ChainLinks[Link - 1]->GetActorLocation(), ChainLinks[Link]->GetActorLocation(), FColor::Cyan);
+		}
+
+		DamageSingleEnemy(Cast<AWSEnemyBase>(ChainLinks[Link]), LinkScale);
+		LinkScale *= ChainDamageFalloff;
+	}
+}
+
+void AWSWeaponBase::DamageSingleEnemy(AWSEnemyBase* Enemy, float DamageScale)
+{
+	if (!GetOwner() || !Enemy || Enemy->IsPooled())
+	{
+		return;
+	}
+
+	bool bIsCritical = false;
+	const float Damage = CalculateDamage(bIsCritical) * DamageScale;
+
+	FWSDamageEvent Event;
+	Event.Target = Enemy->GetEnemyHandle();
+	Event.Amount = Damage;
+	Event.InstigatorSlot = GetStatSnapshot().PlayerSlot;
+	Event.Element = ElementalType;
+	Event.bIsCritical = bIsCritical;
+
+	// Damage, elemental effects and kill credit are applied by the damage subsystem once per frame
+	UWSDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UWSDamageSubsystem>();
+	if (DamageSubsystem && Event.Target.IsSet())
+	{
+		DamageSubsystem->QueueDamage(Event);
+		return;
+	}
+
+	// Enemies outside the enemy manager take the hit immediately
+	const bool bKilledEnemy = Enemy->TakeDamageFromSlot(Damage, Event.InstigatorSlot, bIsCritical);
+	if (!bKilledEnemy && ElementalType != EWSElementalType::None)
+	{
+		Enemy->ApplyElementalEffect(ElementalType, Event.InstigatorSlot);
+	}
+
+	if (bKilledEnemy)
+	{
+		AWSPlayerState* PS = SnapshotPlayerState.Get();
+		if (PS)
+		{
+			PS->OnKill();
+		}
 	}
 }
 
 void AWSWeaponBase::PerformProjectile()
 {
-	// Projectile implementation would spawn a projectile actor
-	UE_LOG(LogTemp, Log, TEXT("Projectile fired"));
+	FVector TraceStart;
+	FVector TraceEnd;
+	if (!GetHitscanRay(TraceStart, TraceEnd))
+	{
+		return;
+	}
+
+	// Projectiles are simulated in bulk by the projectile subsystem, not as actors. A predicting client's
+	// copy has no weapon, so it stops on what it hits without dealing damage.
+	UWSProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UWSProjectileSubsystem>();
+	if (ProjectileSubsystem)
+	{
+		const FVector Velocity = (TraceEnd - TraceStart).GetSafeNormal() * ProjectileSpeed;
+		ProjectileSubsystem->SpawnProjectile(IsPredictingClient() ? nullptr : this, TraceStart, Velocity, Range, ProjectileRadius);
+	}
 }
 
 void AWSWeaponBase::PerformMelee()
 {
-	// Melee implementation would do a sphere trace
-	UE_LOG(LogTemp, Log, TEXT("Melee attack"));
+	const AActor* OwnerActor = GetOwner();
+	UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (!OwnerActor || !SpatialGrid)
+	{
+		return;
+	}
+
+	// Swing in the horizontal aim direction
+	FVector EyeLocation;
+	FRotator EyeRotation;
+	OwnerActor->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+
+	const FVector Origin = OwnerActor->GetActorLocation();
+	const FVector Direction = FRotator(0.0f, EyeRotation.Yaw, 0.0f).Vector();
+
+	// Analytic cone test against the enemy grid instead of a physics sweep
+	if (SpatialGrid->QueryCone(Origin, Direction, Range, MeleeHalfAngle, EWSSpatialCategory::Enemy, MeleeCandidates) == 0)
+	{
+		return;
+	}
+
+	// Closest enemies first, capped at MaxMeleeTargets
+	MeleeCandidates.Sort([&Origin](const AActor& A, const AActor& B)
+	{
+		return FVector::DistSquared(Origin, A.GetActorLocation()) < FVector::DistSquared(Origin, B.GetActorLocation());
+	});
+
+	// For chaining weapons the closest enemy starts the chain
+	const int32 NumTargets = MaxMeleeTargets > 0 ? FMath::Min(MeleeCandidates.Num(), MaxMeleeTargets) : MeleeCandidates.Num();
+	for (int32 i = 0; i < NumTargets; ++i)
+	{
+		DamageEnemy(Cast<AWSEnemyBase>(MeleeCandidates[i]), 1.0f, i == 0);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Melee swing hit %d enemies"), NumTargets);
 }
 
 void AWSWeaponBase::FinishReload()
@@ -243,68 +902,51 @@ void AWSWeaponBase::FinishReload()
 
 float AWSWeaponBase::CalculateDamage(bool& bOutIsCritical)
 {
-	float FinalDamage = BaseDamage;
-	bOutIsCritical = false;
+	const FWSWeaponStatSnapshot& Stats = GetStatSnapshot();
 
-	ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner());
-	if (OwnerCharacter)
+	// Apply damage multiplier
+	float FinalDamage = BaseDamage * Stats.DamageMultiplier;
+
+	// Check for critical hit
+	bOutIsCritical = FMath::FRand() < Stats.CriticalChance;
+	if (bOutIsCritical)
 	{
-		AWSPlayerState* PS = Cast<AWSPlayerState>(OwnerCharacter->GetPlayerState());
-		if (PS)
-		{
-			// Apply damage multiplier
-			FinalDamage *= PS->PlayerStats.DamageMultiplier;
-
-			// Check for critical hit
-			float CritRoll = FMath::FRand();
-			if (CritRoll < PS->PlayerStats.CriticalChance)
-			{
-				bOutIsCritical = true;
-				FinalDamage *= PS->PlayerStats.CriticalDamageMultiplier;
-			}
-		}
+		FinalDamage *= Stats.CriticalDamageMultiplier;
 	}
 
 	// Add elemental damage
-	if (ElementalType != EWSElementalType::None)
+	FinalDamage += (FinalDamage * Stats.ElementalDamagePercent);
+
+	return FinalDamage;
+}
+
+float AWSWeaponBase::GetFalloffMultiplier(float Distance) const
+{
+	if (Distance <= FalloffStartRange || FalloffEndRange <= FalloffStartRange)
 	{
-		FinalDamage += (FinalDamage * ElementalDamagePercent);
+		return 1.0f;
 	}
 
-	return FinalDamage;
+	const float Alpha = FMath::Clamp((Distance - FalloffStartRange) / (FalloffEndRange - FalloffStartRange), 0.0f, 1.0f);
+	return FMath::Lerp(1.0f, MinFalloffMultiplier, Alpha);
 }
 
-void AWSWeaponBase::ApplyElementalEffect(AActor* Target)
+float AWSWeaponBase::GetRegionMultiplier(const FHitResult& HitResult) const
 {
-	// Apply elemental status effects based on type
-	switch (ElementalType)
+	if (bAllShotsHeadshots)
 	{
-		case EWSElementalType::Fire:
-			// Apply burn damage over time
-			UE_LOG(LogTemp, Log, TEXT("Applied fire effect"));
-			break;
-			
-		case EWSElementalType::Ice:
-			// Slow enemy
-			UE_LOG(LogTemp, Log, TEXT("Applied ice effect"));
-			break;
-			
-		case EWSElementalType::Electric:
-			// Chain damage to nearby enemies
-			UE_LOG(LogTemp, Log, TEXT("Applied electric effect"));
-			break;
-			
-		case EWSElementalType::Acid:
-			// Reduce armor
-			UE_LOG(LogTemp, Log, TEXT("Applied acid effect"));
-			break;
-			
-		case EWSElementalType::Poison:
-			// Poison damage over time
-			UE_LOG(LogTemp, Log, TEXT("Applied poison effect"));
-			break;
-			
+		return HeadshotMultiplier;
+	}
+
+	switch (UWSHitboxSubsystem::GetHitRegion(HitResult))
+	{
+		case EWSHitRegion::Head:
+			return HeadshotMultiplier;
+
+		case EWSHitRegion::Limb:
+			return LimbMultiplier;
+
 		default:
-			break;
+			return 1.0f;
 	}
 }
@@ -0,0 +1,286 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WSZoneSubsystem.h"
+#include "WaveSurvival.h"
+#include "WSCharacterBase.h"
+#include "WSEnemyBase.h"
+#include "WSEnemyManagerSubsystem.h"
+#include "WSDamageSubsystem.h"
+#include "WSSpatialGridSubsystem.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Zone Step"), STAT_WSZoneStep, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Zones"), STAT_WSActiveZones, STATGROUP_WaveSurvival);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Zone Members"), STAT_WSZoneMembers, STATGROUP_WaveSurvival);
+
+UWSZoneSubsystem::UWSZoneSubsystem()
+{
+	StepInterval = 0.2f;
+	MaxStepsPerFrame = 2;
+
+	NextZoneId = 0;
+	StepAccumulator = 0.0f;
+}
+
+bool UWSZoneSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWSZoneSubsystem::Deinitialize()
+{
+	// Members are being torn down with the world; nothing to restore
+	Zones.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWSZoneSubsystem::Tick(float DeltaTime)
+{
+	StepAccumulator += DeltaTime;
+
+	int32 NumSteps = 0;
+	while (StepAccumulator >= StepInterval && NumSteps < MaxStepsPerFrame)
+	{
+		Step(StepInterval);
+		StepAccumulator -= StepInterval;
+		NumSteps++;
+	}
+
+	// Drop whatever is left after a long hitch rather than spiral
+	if (NumSteps == MaxStepsPerFrame)
+	{
+		StepAccumulator = FMath::Min(StepAccumulator, StepInterval);
+	}
+
+	SET_DWORD_STAT(STAT_WSActiveZones, Zones.Num());
+	SET_DWORD_STAT(STAT_WSZoneMembers, GetTotalMemberCount());
+}
+
+TStatId UWSZoneSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWSZoneSubsystem, STATGROUP_Tickables);
+}
+
+int32 UWSZoneSubsystem::AddZone(const FWSZoneSpec& Spec, const FTransform& Transform, int32 InstigatorSlot)
+{
+	FZone& Zone = Zones.AddDefaulted_GetRef();
+	Zone.Id = NextZoneId++;
+	Zone.Spec = Spec;
+	Zone.Transform = Transform;
+	Zone.RemainingTime = Spec.Duration;
+	Zone.InstigatorSlot = InstigatorSlot;
+
+	return Zone.Id;
+}
+
+bool UWSZoneSubsystem::SetZoneTransform(int32 ZoneId, const FTransform& Transform)
+{
+	FZone* Zone = Zones.FindByPredicate([ZoneId](const FZone& Candidate)
+	{
+		return Candidate.Id == ZoneId;
+	});
+
+	if (!Zone)
+	{
+		return false;
+	}
+
+	Zone->Transform = Transform;
+	return true;
+}
+
+bool UWSZoneSubsystem::RemoveZone(int32 ZoneId)
+{
+	const int32 ZoneIndex = Zones.IndexOfByPredicate([ZoneId](const FZone& Candidate)
+	{
+		return Candidate.Id == ZoneId;
+	});
+
+	if (ZoneIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	RemoveZoneAt(ZoneIndex);
+	return true;
+}
+
+int32 UWSZoneSubsystem::GetZoneCount() const
+{
+	return Zones.Num();
+}
+
+int32 UWSZoneSubsystem::GetTotalMemberCount() const
+{
+	int32 Total = 0;
+	for (const FZone& Zone : Zones)
+	{
+		Total += Zone.Members.Num();
+	}
+	return Total;
+}
+
+void UWSZoneSubsystem::Step(float StepTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WSZoneStep);
+
+	UWSDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UWSDamageSubsystem>();
+
+	// Iterate backwards so swap-removal doesn't skip anything
+	for (int32 ZoneIndex = Zones.Num() - 1; ZoneIndex >= 0; --ZoneIndex)
+	{
+		FZone& Zone = Zones[ZoneIndex];
+		if (Zone.Spec.Duration > 0.0f)
+		{
+			Zone.RemainingTime -= StepTime;
+			if (Zone.RemainingTime <= 0.0f)
+			{
+				RemoveZoneAt(ZoneIndex);
+				continue;
+			}
+		}
+
+		GatherMembers(Zone, NewMembers);
+
+		// Both lists are sorted, so one merge pass finds arrivals and departures
+		int32 OldIndex = 0;
+		int32 NewIndex = 0;
+		while (OldIndex < Zone.Members.Num() || NewIndex < NewMembers.Num())
+		{
+			if (NewIndex == NewMembers.Num() || (OldIndex < Zone.Members.Num() && Zone.Members[OldIndex].Key < NewMembers[NewIndex].Key))
+			{
+				ApplyModifier(Zone, Zone.Members[OldIndex++], -1.0f);
+			}
+			else if (OldIndex == Zone.Members.Num() || NewMembers[NewIndex].Key < Zone.Members[OldIndex].Key)
+			{
+				ApplyModifier(Zone, NewMembers[NewIndex++], 1.0f);
+			}
+			else
+			{
+				OldIndex++;
+				NewIndex++;
+			}
+		}
+
+		Swap(Zone.Members, NewMembers);
+
+		// Damage goes through the damage subsystem so pools coalesce with every other hit this frame
+		if (Zone.Spec.DamagePerSecond > 0.0f && DamageSubsystem && !AffectsPlayers(Zone.Spec))
+		{
+			for (const FZoneMember& Member : Zone.Members)
+			{
+				FWSDamageEvent Event;
+				Event.Target = Member.Handle;
+				Event.Amount = Zone.Spec.DamagePerSecond * StepTime;
+				Event.InstigatorSlot = Zone.InstigatorSlot;
+				DamageSubsystem->QueueDamage(Event);
+			}
+		}
+	}
+}
+
+void UWSZoneSubsystem::RemoveZoneAt(int32 ZoneIndex)
+{
+	const FZone& Zone = Zones[ZoneIndex];
+	for (const FZoneMember& Member : Zone.Members)
+	{
+		ApplyModifier(Zone, Member, -1.0f);
+	}
+
+	Zones.RemoveAtSwap(ZoneIndex, 1, EAllowShrinking::No);
+}
+
+void UWSZoneSubsystem::GatherMembers(const FZone& Zone, TArray<FZoneMember>& OutMembers)
+{
+	OutMembers.Reset();
+
+	const UWSSpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<UWSSpatialGridSubsystem>();
+	if (!SpatialGrid)
+	{
+		return;
+	}
+
+	const bool bPlayers = AffectsPlayers(Zone.Spec);
+	const bool bBox = Zone.Spec.Shape == EWSZoneShape::Box;
+	const FVector Center = Zone.Transform.GetLocation();
+
+	// Boxes query their bounding sphere, then test in zone space
+	const float QueryRadius = bBox ? Zone.Spec.HalfExtent.Size() : Zone.Spec.Radius;
+	SpatialGrid->QueryRadius(Center, QueryRadius, bPlayers ? EWSSpatialCategory::Player : EWSSpatialCategory::Enemy, Candidates);
+
+	for (AActor* Actor : Candidates)
+	{
+		if (bBox)
+		{
+			const FVector LocalPosition = Zone.Transform.InverseTransformPositionNoScale(Actor->GetActorLocation()).GetAbs();
+			if (LocalPosition.X > Zone.Spec.HalfExtent.X || LocalPosition.Y > Zone.Spec.HalfExtent.Y || LocalPosition.Z > Zone.Spec.HalfExtent.Z)
+			{
+				continue;
+			}
+		}
+
+		FZoneMember Member;
+		Member.Actor = Actor;
+
+		if (bPlayers)
+		{
+			Member.Key = (uint64)(UPTRINT)Actor;
+		}
+		else
+		{
+			const AWSEnemyBase* Enemy = Cast<AWSEnemyBase>(Actor);
+			if (!Enemy || Enemy->IsPooled() || !Enemy->GetEnemyHandle().IsSet())
+			{
+				continue;
+			}
+
+			Member.Handle = Enemy->GetEnemyHandle();
+			Member.Key = ((uint64)(uint32)Member.Handle.Index << 32) | (uint32)Member.Handle.Generation;
+		}
+
+		OutMembers.Add(Member);
+	}
+
+	OutMembers.Sort();
+}
+
+void UWSZoneSubsystem::ApplyModifier(const FZone& Zone, const FZoneMember& Member, float Sign) const
+{
+	const float Delta = Zone.Spec.Magnitude * Sign;
+	if (Delta == 0.0f)
+	{
+		return;
+	}
+
+	if (AffectsPlayers(Zone.Spec))
+	{
+		if (AWSCharacterBase* Character = Cast<AWSCharacterBase>(Member.Actor.Get()))
+		{
+			Character->AddZoneDamageReduction(Delta);
+		}
+		return;
+	}
+
+	// A stale handle means the enemy died or was pooled, which already cleared its modifiers
+	const UWSEnemyManagerSubsystem* EnemyManager = GetWorld()->GetSubsystem<UWSEnemyManagerSubsystem>();
+	AWSEnemyBase* Enemy = EnemyManager ? EnemyManager->GetEnemy(Member.Handle) : nullptr;
+	if (!Enemy || Enemy->IsPooled())
+	{
+		return;
+	}
+
+	if (Zone.Spec.Effect == EWSZoneEffect::Slow)
+	{
+		Enemy->AddZoneModifiers(Delta, 0.0f);
+	}
+	else
+	{
+		Enemy->AddZoneModifiers(0.0f, Delta);
+	}
+}
+
+bool UWSZoneSubsystem::AffectsPlayers(const FWSZoneSpec& Spec)
+{
+	return Spec.Effect == EWSZoneEffect::Shield;
+}
@@ -22,8 +22,10 @@ public:
 	AWSCharacterBase();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	// Character class
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Character")
@@ -33,7 +35,8 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon")
 	TSubclassOf<AWSWeaponBase> WeaponClass;
 
-	UPROPERTY(BlueprintReadOnly, Category = "Weapon")
+	// Spawned by the server; the owning client predicts its shots
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Weapon")
 	AWSWeaponBase* CurrentWeapon;
 
 	// Abilities
@@ -68,6 +71,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat")
 	virtual void TakeDamageCustom(float DamageAmount, AActor* DamageCauser);
 
+	// Added on entering and subtracted on leaving a shield zone by UWSZoneSubsystem
+	void AddZoneDamageReduction(float Delta);
+
 	// Abilities
 	UFUNCTION(BlueprintCallable, Category = "Abilities")
 	virtual void UseAbility1();
@@ -101,6 +107,9 @@ protected:
 	bool bIsReloading;
 	bool bIsDowned;
 
+	// Summed damage reduction of every shield zone the character is in
+	float ZoneDamageReduction;
+
 	void UpdateCooldowns(float DeltaTime);
 	void ApplyHealthRegen(float DeltaTime);
 };
@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/Queue.h"
+#include "WSTypes.h"
+#include "WSDamageSubsystem.generated.h"
+
+class AWSEnemyBase;
+
+/**
+ * One hit against an enemy, before armor and the enemy's critical multiplier are applied
+ */
+struct FWSDamageEvent
+{
+	FWSEnemyHandle Target;
+	float Amount = 0.0f;
+	int32 InstigatorSlot = INDEX_NONE;
+	EWSElementalType Element = EWSElementalType::None;
+	bool bIsCritical = false;
+};
+
+/**
+ * Collects damage events from any thread and applies them once per frame on the game thread.
+ * All hits on one enemy in a frame become a single health change, health bar update and death check,
+ * with kill credit going to the slot whose hit took the enemy's health to zero.
+ */
+UCLASS()
+class WAVESURVIVAL_API UWSDamageSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Safe to call from any thread
+	void QueueDamage(const FWSDamageEvent& Event);
+
+	// Applies every queued event now. Called from Tick; game thread only.
+	void ResolvePendingDamage();
+
+	// Applies Events immediately as one batch, bypassing the queue. OutDied[i] is set when the target
+	// of event i died in this batch. Called while another batch resolves (e.g. from Die()), the events
+	// are queued for the next frame instead and OutDied is all false. Game thread only.
+	void ApplyDamageBatch(TConstArrayView<FWSDamageEvent> Events, TBitArray<>& OutDied);
+
+	// Damage left after armor and the critical multiplier; the scalar reference for MitigateDamageBatch
+	static float MitigateDamage(float Amount, float Armor, float CritMultiplier);
+
+	// Four hits per iteration, bit-identical to calling MitigateDamage on each element
+	static void MitigateDamageBatch(const float* Amounts, const float* Armors, const float* CritMultipliers, float* OutDamages, int32 Count);
+
+protected:
+	TQueue<FWSDamageEvent, EQueueMode::Mpsc> PendingEvents;
+
+	// Events drained from the queue this frame
+	TArray<FWSDamageEvent> FrameEvents;
+
+	struct FEnemyDamage
+	{
+		AWSEnemyBase* Enemy = nullptr;
+		FWSDamageLedger Damage;
+		float TotalDamage = 0.0f;
+		int32 KillingSlot = INDEX_NONE;
+		uint8 ElementMask = 0;
+		bool bKilled = false;
+
+		// Latest slot to apply each element, valid where ElementMask is set
+		int32 ElementSlots[(int32)EWSElementalType::Poison + 1] = {};
+	};
+
+	// Per-frame scratch, one entry per enemy hit this frame in order of first hit
+	TArray<FEnemyDamage> FrameDamage;
+	TMap<FWSEnemyHandle, int32> FrameDamageIndices;
+
+	// Per-event scratch: resolved enemy, packed kernel inputs and output, and FrameDamage entry
+	TArray<AWSEnemyBase*> EventEnemies;
+	TArray<float> PackedAmounts;
+	TArray<float> PackedArmors;
+	TArray<float> PackedCritMultipliers;
+	TArray<float> MitigatedDamages;
+	TArray<int32> EventEntries;
+
+	// Guards the scratch buffers against re-entry from Die()
+	bool bResolving = false;
+
+	void ResolveEvents(TConstArrayView<FWSDamageEvent> Events, TBitArray<>* OutDied);
+};
@@ -19,7 +19,7 @@ public:
 	AWSEnemyBase();
 
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// Enemy configuration
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Enemy")
@@ -34,10 +34,54 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
 	float CriticalDamageMultiplier = 2.0f;
 
+	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	float AttackRange = 150.0f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	float AttackCooldown = 1.0f;
+
+	// Blast queued on death by exploding enemy types (Xurkex, Queen Larvae)
+	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	float DeathExplosionRadius = 400.0f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	float DeathExplosionDamage = 60.0f;
+
+	// Penetration budget a piercing shot spends passing through this enemy
+	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	float PenetrationResistance = 1.0f;
+
+	// Shapes weapon rays are tested against, relative to the actor. Keep within UWSHitboxSubsystem::MaxHitboxReach.
+	UPROPERTY(EditDefaultsOnly, Category = "Hitboxes")
+	TArray<FWSHitbox> Hitboxes;
+
 	// Combat
 	UFUNCTION(BlueprintCallable, Category = "Combat")
 	virtual bool TakeDamageCustom(float DamageAmount, AActor* DamageCauser, bool bIsCritical);
 
+	// Damage attributed to a player slot; TakeDamageCustom resolves the slot from the causer
+	virtual bool TakeDamageFromSlot(float DamageAmount, int32 InstigatorSlot, bool bIsCritical);
+
+	// Damage left after armor and this enemy's critical multiplier
+	float GetMitigatedDamage(float DamageAmount, bool bIsCritical) const;
+
+	// Inputs to the damage mitigation; armor is not yet clamped
+	float GetEffectiveArmor() const;
+	float GetCritMultiplier(bool bIsCritical) const;
+
+	// Applies one frame of already-mitigated damage from UWSDamageSubsystem. Returns true if it killed the enemy.
+	bool ApplyResolvedDamage(const FWSDamageLedger& FrameDamage, float TotalDamage);
+
+	// Hands the element to UWSStatusEffectSubsystem
+	virtual void ApplyElementalEffect(EWSElementalType Element, int32 InstigatorSlot);
+
+	// Status effect modifiers, set by UWSStatusEffectSubsystem
+	void SetSlowFraction(float InSlowFraction);
+	void SetArmorShred(float InArmorShred);
+
+	// Zone modifiers, added on entering and subtracted on leaving a zone by UWSZoneSubsystem
+	void AddZoneModifiers(float SlowDelta, float ArmorShredDelta);
+
 	UFUNCTION(BlueprintCallable, Category = "Combat")
 	virtual void Die();
 
@@ -51,17 +95,51 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AI")
 	AActor* FindHighestDamageDealer();
 
+	// Set by the enemy manager's batch update
+	void SetCurrentTarget(AActor* NewTarget);
+
+	FWSEnemyHandle GetEnemyHandle() const;
+
+	const FWSDamageLedger& GetDamageLedger() const { return DamageLedger; }
+
+	// Restores health and damage credit carried over from a Mass entity
+	void ApplyPromotedState(float Health, const FWSDamageLedger& InDamageLedger);
+
 	// Health bar
 	UFUNCTION(BlueprintImplementableEvent, Category = "UI")
 	void UpdateHealthBar();
 
+	// Pooling
+	UFUNCTION(BlueprintCallable, Category = "Pooling")
+	bool IsPooled() const;
+
+	void ActivateFromPool(const FVector& Location, const FRotator& Rotation);
+	void DeactivateToPool();
+
 protected:
 	UPROPERTY()
 	AActor* CurrentTarget;
 
-	UPROPERTY()
-	TMap<AActor*, float> DamageReceivedFromPlayers;
+	// Damage received per player slot
+	FWSDamageLedger DamageLedger;
+
+	// Active status effect modifiers
+	float SlowFraction;
+	float ArmorShred;
+
+	// Summed modifiers of every zone the enemy is in
+	float ZoneSlowFraction;
+	float ZoneArmorShred;
+
+	bool bIsPooled;
+
+	// Handle into UWSEnemyManagerSubsystem while the enemy is active
+	FWSEnemyHandle EnemyHandle;
 
 	virtual void OnDeath();
 	void DropCurrency();
+	void ResetEnemyState();
+	void UpdateWalkSpeed();
+	void RegisterWithWorldSystems();
+	void UnregisterFromWorldSystems();
 };
@@ -0,0 +1,162 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WSTypes.h"
+#include "WSEnemyManagerSubsystem.generated.h"
+
+class AWSEnemyBase;
+
+/**
+ * Simulation state for every live enemy of one type, stored as parallel arrays
+ */
+struct WAVESURVIVAL_API FWSEnemyBatch
+{
+	EWSEnemyType EnemyType = EWSEnemyType::Aalix;
+
+	TArray<AWSEnemyBase*> Enemies;
+	TArray<int32> SlotIndices;
+	TArray<FVector> Positions;
+	TArray<TWeakObjectPtr<AActor>> Targets;
+	TArray<float> RetargetTimers;
+	TArray<float> AttackTimers;
+	TArray<float> AttackRanges;
+	TArray<float> AttackCooldowns;
+
+	// Significance state
+	TArray<EWSEnemyLOD> LODs;
+	TArray<float> LODTimers;
+	TArray<float> UpdateAccumulators;
+
+	// Time to simulate for each enemy this frame, 0 when its bucket skips the frame
+	TArray<float> StepDeltaTimes;
+
+	// Push away from nearby enemies, refreshed when the enemy updates
+	TArray<FVector> Separations;
+
+	int32 Num() const { return Enemies.Num(); }
+};
+
+/** Per-type update hook, called once per frame with the whole batch */
+using FWSEnemyBatchUpdateFunction = TFunction<void(FWSEnemyBatch& Batch, float DeltaTime)>;
+
+/**
+ * Owns enemy simulation state and updates each enemy type in one loop instead of per-actor ticks.
+ * Enemies are bucketed by significance (distance to the nearest player, on-screen relevance),
+ * and each bucket scales how often they update, retarget and move.
+ */
+UCLASS(Config = Game)
+class WAVESURVIVAL_API UWSEnemyManagerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWSEnemyManagerSubsystem();
+
+	static constexpr int32 NumEnemyTypes = (int32)EWSEnemyType::QueenLarvae + 1;
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Registration
+	FWSEnemyHandle RegisterEnemy(AWSEnemyBase* Enemy);
+	void UnregisterEnemy(const FWSEnemyHandle& Handle);
+
+	// Lookup
+	bool IsValidHandle(const FWSEnemyHandle& Handle) const;
+	AWSEnemyBase* GetEnemy(const FWSEnemyHandle& Handle) const;
+	AActor* GetTarget(const FWSEnemyHandle& Handle) const;
+
+	// Upper bound (exclusive) on handle indices; slots are reused, so this is the peak live enemy count
+	int32 GetSlotCount() const { return Slots.Num(); }
+
+	UFUNCTION(BlueprintCallable, Category = "Enemy")
+	int32 GetEnemyCount(EWSEnemyType EnemyType) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Enemy")
+	int32 GetTotalEnemyCount() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Enemy")
+	int32 GetLODPopulation(EWSEnemyLOD LOD) const;
+
+	const FWSEnemyLODSettings& GetLODSettings(EWSEnemyLOD LOD) const;
+
+	// Replaces the default targeting/attack update for one enemy type
+	void SetBatchUpdateHook(EWSEnemyType EnemyType, FWSEnemyBatchUpdateFunction Hook);
+	void ClearBatchUpdateHook(EWSEnemyType EnemyType);
+
+	FWSEnemyBatch& GetBatch(EWSEnemyType EnemyType) { return Batches[(int32)EnemyType]; }
+	const FWSEnemyBatch& GetBatch(EWSEnemyType EnemyType) const { return Batches[(int32)EnemyType]; }
+
+	// Default targeting and attack logic, usable from custom hooks. Both honour Batch.StepDeltaTimes.
+	void UpdateTargeting(FWSEnemyBatch& Batch, float DeltaTime);
+	void UpdateAttacks(FWSEnemyBatch& Batch, float DeltaTime);
+
+	// Steers every enemy with a target along the shared flow field
+	void UpdateMovement(FWSEnemyBatch& Batch, float DeltaTime);
+
+	// Recomputes each updating enemy's push away from its neighbours. Honours Batch.StepDeltaTimes.
+	void UpdateSeparation(FWSEnemyBatch& Batch, float DeltaTime);
+
+protected:
+	// Update rates per significance bucket, indexed by EWSEnemyLOD
+	UPROPERTY(Config, EditAnywhere, Category = "LOD")
+	TArray<FWSEnemyLODSettings> LODSettings;
+
+	// Seconds between significance re-evaluations for each enemy
+	UPROPERTY(Config, EditAnywhere, Category = "LOD")
+	float LODEvaluationInterval;
+
+	// Distance an enemy must move past a bucket boundary before it changes bucket
+	UPROPERTY(Config, EditAnywhere, Category = "LOD")
+	float LODHysteresis;
+
+	// Half angle of a player's view cone; enemies inside it are promoted one bucket
+	UPROPERTY(Config, EditAnywhere, Category = "LOD")
+	float OnScreenHalfAngle;
+
+	// Enemies closer than this push each other apart
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd")
+	float SeparationRadius;
+
+	// Strength of the separation push relative to the steering direction
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd")
+	float SeparationWeight;
+
+	// Scratch buffers for the separation kernel
+	TArray<float> NeighbourX;
+	TArray<float> NeighbourY;
+
+	struct FViewer
+	{
+		FVector Location;
+		FVector ViewDirection;
+	};
+
+	TArray<FViewer> Viewers;
+	int32 LODPopulation[(int32)EWSEnemyLOD::Dormant + 1];
+
+	void GatherViewers();
+	void UpdateSignificance(FWSEnemyBatch& Batch, float DeltaTime);
+	EWSEnemyLOD EvaluateLOD(const FVector& Location, EWSEnemyLOD CurrentLOD) const;
+	void ApplyMovementFidelity(AWSEnemyBase* Enemy, EWSEnemyLOD LOD) const;
+
+	struct FSlot
+	{
+		int32 Generation = 0;
+		EWSEnemyType EnemyType = EWSEnemyType::Aalix;
+		int32 DenseIndex = INDEX_NONE;
+	};
+
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+
+	FWSEnemyBatch Batches[NumEnemyTypes];
+	FWSEnemyBatchUpdateFunction BatchHooks[NumEnemyTypes];
+
+	const FSlot* FindSlot(const FWSEnemyHandle& Handle) const;
+};
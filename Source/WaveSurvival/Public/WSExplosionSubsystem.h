@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WSExplosionSubsystem.generated.h"
+
+/**
+ * Queues radial explosions and resolves a budgeted number per frame against the spatial grid.
+ * Enemy damage goes through UWSDamageSubsystem, so an explosion that kills an exploding enemy
+ * queues the next one for a later frame instead of recursing through Die().
+ */
+UCLASS(Config = Game)
+class WAVESURVIVAL_API UWSExplosionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWSExplosionSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Damage falls off linearly from full at Location to MinFalloffMultiplier at Radius.
+	// Enemy damage is credited to InstigatorSlot.
+	void QueueExplosion(const FVector& Location, float Radius, float Damage, int32 InstigatorSlot, bool bDamagesPlayers);
+
+	UFUNCTION(BlueprintCallable, Category = "Explosion")
+	int32 GetPendingExplosionCount() const;
+
+protected:
+	// Explosions resolved per frame; the rest wait for later frames
+	UPROPERTY(Config, EditAnywhere, Category = "Explosion")
+	int32 MaxExplosionsPerFrame;
+
+	// Damage multiplier at the edge of the blast
+	UPROPERTY(Config, EditAnywhere, Category = "Explosion")
+	float MinFalloffMultiplier;
+
+	struct FPendingExplosion
+	{
+		FVector Location;
+		float Radius;
+		float Damage;
+		int32 InstigatorSlot;
+		bool bDamagesPlayers;
+	};
+
+	// FIFO; entries before NextExplosion have been resolved
+	TArray<FPendingExplosion> PendingExplosions;
+	int32 NextExplosion;
+
+	// Scratch buffer for grid queries
+	TArray<AActor*> Candidates;
+
+	void ResolveExplosion(const FPendingExplosion& Explosion);
+	float GetFalloffMultiplier(float Distance, float Radius) const;
+};
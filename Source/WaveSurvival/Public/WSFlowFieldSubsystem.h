@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "WSFlowFieldSubsystem.generated.h"
+
+/**
+ * Shared flow field toward the nearest player. Basic enemies sample it for their steering
+ * direction instead of running per-agent pathfinding.
+ *
+ * The field is updated on a worker thread whenever a player moves into another cell and
+ * swapped in on the game thread once the build finishes. Updates repair the previous field:
+ * only cells nearest a departed goal are recomputed, and new goals spread only as far as
+ * they are closer than the existing ones. A full build runs when the obstacle mask changes.
+ */
+UCLASS(Config = Game)
+class WAVESURVIVAL_API UWSFlowFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWSFlowFieldSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Unit steering direction at Location, zero when outside the field or already in a goal cell
+	UFUNCTION(BlueprintCallable, Category = "Navigation")
+	FVector GetFlowDirection(FVector Location) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Navigation")
+	bool HasFlowField() const;
+
+	// Forces a rebuild on the next tick even if no player changed cell
+	UFUNCTION(BlueprintCallable, Category = "Navigation")
+	void InvalidateFlowField();
+
+protected:
+	// Edge length of a flow field cell in world units
+	UPROPERTY(Config, EditAnywhere, Category = "Navigation")
+	float CellSize;
+
+	// Number of cells along X and Y, centred on the world origin
+	UPROPERTY(Config, EditAnywhere, Category = "Navigation")
+	int32 GridDimension;
+
+	// Height above the origin at which cells are probed for static obstacles
+	UPROPERTY(Config, EditAnywhere, Category = "Navigation")
+	float ObstacleProbeHeight;
+
+	// Rows of cells probed for obstacles per frame after BeginPlay
+	UPROPERTY(Config, EditAnywhere, Category = "Navigation")
+	int32 ObstacleRowsPerFrame;
+
+	struct FFlowField
+	{
+		// Index into the direction table per cell; 0xFF = no direction (blocked, unreachable or goal)
+		TArray<uint8> Directions;
+
+		// BFS distance and nearest goal cell, kept so the next update can repair rather than rebuild
+		TArray<int32> Distance;
+		TArray<int32> Owner;
+
+		// Cells whose distance changed in the build that produced this field
+		int32 CellsUpdated = 0;
+	};
+
+	struct FFrontierCell
+	{
+		int32 CellIndex;
+		int32 Distance;
+	};
+
+	TSharedPtr<const FFlowField, ESPMode::ThreadSafe> CurrentField;
+	TSharedPtr<FFlowField, ESPMode::ThreadSafe> PendingField;
+	UE::Tasks::FTask BuildTask;
+
+	// Static obstacle mask, filled row by row after BeginPlay
+	TArray<uint8> BlockedCells;
+	TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> BlockedSnapshot;
+	int32 NextObstacleRow;
+
+	TArray<int32> GoalCells;
+	TArray<int32> BuiltGoalCells;
+	bool bForceRebuild;
+
+	FVector2D GetGridOrigin() const;
+	int32 GetCellIndex(const FVector& Location) const;
+
+	void ProbeObstacleRows();
+	void GatherGoalCells(TArray<int32>& OutGoalCells) const;
+	void StartBuild();
+
+	static void BuildField(FFlowField& OutField, int32 Dimension, const TArray<int32>& Goals, const TArray<uint8>* Blocked);
+	static void RepairField(FFlowField& Field, int32 Dimension, const TArray<int32>& PreviousGoals, const TArray<int32>& Goals, const TArray<uint8>* Blocked);
+
+	// Lowers distances outward from Seeds, which must already be written into Field; appends every lowered cell to OutChanged
+	static void PropagateDistances(FFlowField& Field, int32 Dimension, TArray<FFrontierCell>& Seeds, const TArray<uint8>* Blocked, TArray<int32>& OutChanged);
+	static uint8 ComputeDirection(const TArray<int32>& Distance, int32 Dimension, int32 CellIndex, const TArray<uint8>* Blocked);
+};
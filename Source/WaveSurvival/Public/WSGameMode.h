@@ -11,6 +11,18 @@
 class AWSGameState;
 class AWSPlayerController;
 
+/**
+ * Deactivated enemies of one type waiting to be reused
+ */
+USTRUCT()
+struct FWSEnemyPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AWSEnemyBase*> InactiveEnemies;
+};
+
 /**
  * Game Mode handles game rules and spawning logic
  */
@@ -24,6 +36,8 @@ public:
 
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
+	virtual void PostLogin(APlayerController* NewPlayer) override;
+	virtual void Logout(AController* Exiting) override;
 
 	// Wave management
 	UFUNCTION(BlueprintCallable, Category = "Wave")
@@ -35,6 +49,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Wave")
 	void SpawnEnemy(EWSEnemyType EnemyType, FVector SpawnLocation);
 
+	// Enemy pooling
+	UFUNCTION(BlueprintCallable, Category = "Enemy")
+	AWSEnemyBase* AcquireEnemy(EWSEnemyType EnemyType, FVector SpawnLocation);
+
+	UFUNCTION(BlueprintCallable, Category = "Enemy")
+	void ReleaseEnemy(AWSEnemyBase* Enemy);
+
+	UFUNCTION(BlueprintCallable, Category = "Enemy")
+	void PrewarmEnemyPools(int32 WaveNumber);
+
+	UFUNCTION(BlueprintCallable, Category = "Enemy")
+	int32 GetPooledEnemyCount(EWSEnemyType EnemyType) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Enemy")
+	TSubclassOf<AWSEnemyBase> GetEnemyClass(EWSEnemyType EnemyType) const;
+
 	// Player management
 	UFUNCTION(BlueprintCallable, Category = "Player")
 	void PlayerDowned(AController* Player);
@@ -58,6 +88,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Spawn")
 	FVector GetSafeRespawnLocation();
 
+	// Spawn queue progress
+	UFUNCTION(BlueprintCallable, Category = "Spawn")
+	bool IsSpawningWave() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Spawn")
+	int32 GetPendingSpawnCount() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Spawn")
+	float GetSpawnProgress() const;
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Wave")
 	TArray<FWSWaveConfig> MainModeWaveConfigs;
@@ -68,15 +108,49 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Enemy")
 	TMap<EWSEnemyType, TSubclassOf<AWSEnemyBase>> EnemyClasses;
 
+	// Deactivated enemies per type, filled on death and prewarmed during the shop phase
+	UPROPERTY()
+	TMap<EWSEnemyType, FWSEnemyPool> EnemyPools;
+
+	// Pool sizes still to be reached by prewarming
+	TMap<EWSEnemyType, int32> PoolPrewarmTargets;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Spawn")
 	TArray<AActor*> EnemySpawnPoints;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Spawn")
 	float SpawnRadius;
 
+	// Candidate locations sampled when looking for a safe respawn point
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn")
+	int32 SafeRespawnCandidates = 8;
+
+	// Radius in which enemies count against a respawn candidate
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn")
+	float SafeRespawnCheckRadius = 1500.0f;
+
+	// Maximum enemies spawned per frame while a wave is queued (0 = no count limit)
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn")
+	int32 MaxSpawnsPerFrame = 32;
+
+	// Time budget in milliseconds for spawning each frame (0 = no time limit)
+	UPROPERTY(EditDefaultsOnly, Category = "Spawn")
+	float SpawnTimeBudgetMs = 2.0f;
+
 	UPROPERTY()
 	AWSGameState* WSGameState;
 
+	// Wave spawn manifest, drained a few enemies per frame
+	TArray<EWSEnemyType> SpawnQueue;
+	int32 SpawnQueueHead;
+
+	void ComputeSpawnCounts(const FWSWaveConfig& WaveConfig, int32 TotalEnemies, TMap<EWSEnemyType, int32>& OutCounts) const;
+	void BuildSpawnManifest(const FWSWaveConfig& WaveConfig, int32 TotalEnemies, TArray<EWSEnemyType>& OutManifest) const;
+	void ProcessSpawnQueue();
+	void ProcessPoolPrewarm();
+	bool IsSpawnBudgetExhausted(int32 SpawnedThisFrame, double StartTime) const;
+	AWSEnemyBase* SpawnEnemyActor(EWSEnemyType EnemyType, const FVector& SpawnLocation);
+
 	void SetupWaveConfigurations();
 	FWSWaveConfig GetWaveConfig(int32 WaveNumber);
 	void GenerateSurvivalWaveConfig(int32 WaveNumber, FWSWaveConfig& OutConfig);
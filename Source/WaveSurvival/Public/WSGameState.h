@@ -7,6 +7,8 @@
 #include "WSTypes.h"
 #include "WSGameState.generated.h"
 
+class AWSPlayerState;
+
 /**
  * Game State tracks the current state of the match
  */
@@ -77,6 +79,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Wave")
 	void EnemyKilled();
 
+	UFUNCTION(BlueprintCallable, Category = "Wave")
+	int32 CalculateEnemyCountForWave(int32 WaveNumber) const;
+
+	// Player slots
+	UFUNCTION(BlueprintCallable, Category = "Players")
+	bool AssignPlayerSlot(AWSPlayerState* PlayerState);
+
+	UFUNCTION(BlueprintCallable, Category = "Players")
+	void ReleasePlayerSlot(AWSPlayerState* PlayerState);
+
+	UFUNCTION(BlueprintCallable, Category = "Players")
+	AWSPlayerState* GetPlayerStateForSlot(int32 Slot) const;
+
+	// Splits an enemy's currency drop between players by their share of its max health
+	void AwardKillCurrency(const FWSDamageLedger& DamageLedger, float MaxHealth, int32 CurrencyDropAmount);
+
 	UFUNCTION(BlueprintCallable, Category = "Game")
 	bool IsGameOver() const;
 
@@ -86,6 +104,10 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 protected:
+	// Player states by slot, server only
+	UPROPERTY()
+	AWSPlayerState* SlotPlayerStates[WSMaxPlayers];
+
 	bool bGameOver;
 	bool bVictory;
 };
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/OverlapResult.h"
+#include "WorldCollision.h"
+#include "WSTypes.h"
+#include "WSHitboxSubsystem.generated.h"
+
+/**
+ * Tests weapon rays against the analytic hitboxes declared by each enemy class instead of the physics scene.
+ * Candidates come from the spatial grid and are tested four hitboxes at a time; physics is only traced
+ * for world occlusion. Enemy hits are reported as FHitResults naming the region in BoneName.
+ */
+UCLASS(Config = Game)
+class WAVESURVIVAL_API UWSHitboxSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWSHitboxSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// RewindTimestamp is the server world time to test enemies at, from UWSLagCompensationSubsystem's
+	// history; negative tests them where they are now.
+
+	// Nearest enemy hitbox along the segment
+	bool RaycastHitboxes(const FVector& Start, const FVector& End, FHitResult& OutHit, double RewindTimestamp = -1.0);
+
+	// Nearest enemy hitbox along each of several segments from one start, e.g. shotgun pellets, from a
+	// single grid query around them all. OutHits must match Ends in size; misses have bBlockingHit false.
+	void RaycastHitboxesBatch(const FVector& Start, TConstArrayView<FVector> Ends, TArrayView<FHitResult> OutHits, double RewindTimestamp = -1.0);
+
+	// Nearest hitbox of every enemy along the segment, sorted by distance
+	int32 RaycastHitboxesMulti(const FVector& Start, const FVector& End, TArray<FHitResult>& OutHits, double RewindTimestamp = -1.0);
+
+	// Traces world geometry for occlusion and hitboxes for enemies, returning whichever is hit first
+	bool TraceHitscan(const FVector& Start, const FVector& End, const FCollisionQueryParams& QueryParams, FHitResult& OutHit, double RewindTimestamp = -1.0);
+
+	// TraceHitscan for every segment of a spread, with one world overlap and one grid query for all of them
+	void TraceHitscanBatch(const FVector& Start, TConstArrayView<FVector> Ends, const FCollisionQueryParams& QueryParams, TArrayView<FHitResult> OutHits, double RewindTimestamp = -1.0);
+
+	// Every enemy in front of the first world occluder, nearest first. OutWorldHit.bBlockingHit is set if the ray was occluded.
+	int32 TraceHitscanMulti(const FVector& Start, const FVector& End, const FCollisionQueryParams& QueryParams, TArray<FHitResult>& OutEnemyHits, FHitResult& OutWorldHit, double RewindTimestamp = -1.0);
+
+	// Picks the enemy hit unless world geometry blocks the ray before it
+	static bool SelectHit(bool bHitEnemy, const FHitResult& EnemyHit, bool bHitWorld, const FHitResult& WorldHit, FHitResult& OutHit);
+
+	// Object types that occlude hitscan shots
+	static FCollisionObjectQueryParams GetOcclusionObjectParams();
+
+	// Box enclosing every segment from Start to Ends, for gathering their occluders with one overlap
+	static FCollisionShape GetSpreadBounds(const FVector& Start, TConstArrayView<FVector> Ends, FVector& OutCenter, FQuat& OutRotation);
+
+	// Nearest hit along the segment on any of the overlapped occluders
+	static bool TraceOccluders(TConstArrayView<FOverlapResult> Occluders, const FVector& Start, const FVector& End, FHitResult& OutHit);
+
+	// Region of an enemy hit from RaycastHitboxes; Body for anything else
+	static EWSHitRegion GetHitRegion(const FHitResult& Hit);
+
+	/**
+	 * Entry distance along a normalized ray for Count vertical capsules, FLT_MAX where the ray misses.
+	 * Centres are relative to the ray start. Count must be a multiple of four; pad with a negative RadiusSq.
+	 */
+	static void RaycastCapsules(const FVector3f& Direction, float Length, const float* InCenterX, const float* InCenterY, const float* InCenterZ,
+		const float* InHalfHeights, const float* InRadiiSq, float* OutDistances, int32 Count);
+
+	// Logs the average cost of hitbox rays against physics traces through the live horde, and of rays rewound by RewindSeconds
+	void RunBenchmark(int32 NumRays, float Range, float RewindSeconds);
+
+protected:
+	// Farthest any hitbox surface reaches from its actor's origin; pads the grid query
+	UPROPERTY(Config, EditAnywhere, Category = "Hitboxes")
+	float MaxHitboxReach;
+
+	// Scratch buffers: grid candidates and packed hitboxes
+	TArray<AActor*> Candidates;
+	TArray<float> CenterX;
+	TArray<float> CenterY;
+	TArray<float> CenterZ;
+	TArray<float> HalfHeights;
+	TArray<float> RadiiSq;
+	TArray<float> Distances;
+	TArray<int32> HitboxOwners;
+	TArray<EWSHitRegion> HitboxRegions;
+
+	// Packs the hitboxes of every enemy near the segment and fills Distances. Returns the unpadded hitbox count.
+	int32 RaycastCandidates(const FVector& Start, const FVector& End, double RewindTimestamp);
+
+	// Packs the hitboxes of every enemy within ExtraRadius of the segment, without testing them
+	int32 PackCandidates(const FVector& Start, const FVector& End, float ExtraRadius, double RewindTimestamp);
+
+	// Fills Distances for one ray against the packed hitboxes
+	void RaycastPacked(const FVector& Start, const FVector& End, int32 NumHitboxes);
+
+	// Index of the nearest packed hitbox hit by the last RaycastPacked, INDEX_NONE if none
+	int32 FindNearestHitbox(int32 NumHitboxes) const;
+
+	// Axis and radius of a cone of segments sharing a start
+	static void GetSpreadAxis(const FVector& Start, TConstArrayView<FVector> Ends, FVector& OutDirection, float& OutLength, float& OutRadius);
+	void MakeHit(int32 HitboxIndex, const FVector& Start, const FVector& End, FHitResult& OutHit) const;
+};
@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "WSHitscanSubsystem.generated.h"
+
+class AWSWeaponBase;
+
+/**
+ * Queues hitscan shots as async world-occlusion traces and applies their hits on the following frame,
+ * in the order the shots were fired. Enemy hitboxes are tested when the shot is queued.
+ */
+UCLASS()
+class WAVESURVIVAL_API UWSHitscanSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void QueueShot(AWSWeaponBase* Weapon, const FVector& TraceStart, const FVector& TraceEnd);
+
+	// Queues every pellet of one shot behind a single world overlap and hitbox query; they are resolved
+	// together through AWSWeaponBase::ApplyPelletResults
+	void QueueShotBatch(AWSWeaponBase* Weapon, const FVector& TraceStart, const TArray<FVector>& TraceEnds);
+
+	UFUNCTION(BlueprintCallable, Category = "Weapon")
+	int32 GetPendingShotCount() const;
+
+protected:
+	struct FPendingShot
+	{
+		TWeakObjectPtr<AWSWeaponBase> Weapon;
+		FVector TraceStart;
+		TArray<FVector, TInlineAllocator<1>> TraceEnds;
+		TArray<FTraceHandle, TInlineAllocator<1>> TraceHandles;
+
+		// Pellet batches gather the occluders of every pellet with one overlap instead of a trace each
+		FTraceHandle OverlapHandle;
+
+		// Nearest enemy hitbox per trace; bBlockingHit is false where the trace missed every enemy
+		TArray<FHitResult, TInlineAllocator<1>> EnemyHits;
+		uint64 SubmitFrame;
+		bool bIsPelletBatch;
+	};
+
+	TArray<FPendingShot> PendingShots;
+
+	void ResolveShot(const FPendingShot& Shot);
+	bool GetTraceResult(const FPendingShot& Shot, int32 TraceIndex, FHitResult& OutHit) const;
+	void GetPelletOccluders(const FPendingShot& Shot, TArray<FOverlapResult>& OutOccluders) const;
+
+	// Starts the world trace and tests hitboxes, rewound to RewindTimestamp if not negative, for one trace of Shot
+	void QueueTrace(FPendingShot& Shot, const FVector& TraceEnd, const FCollisionQueryParams& QueryParams, double RewindTimestamp);
+};
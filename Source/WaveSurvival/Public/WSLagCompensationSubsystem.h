@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WSTypes.h"
+#include "WSLagCompensationSubsystem.generated.h"
+
+/**
+ * Server-side history of enemy transforms for rewinding client shots.
+ * Every RecordInterval the location and yaw of each live enemy is written into a ring of frames, as packed
+ * arrays indexed by enemy handle slot. The ring holds MaxRewindTime / RecordInterval frames whatever the
+ * server frame rate, and memory is that times slot capacity; rewinding is a lookup and lerp per candidate
+ * enemy, done by UWSHitboxSubsystem.
+ */
+UCLASS(Config = Game)
+class WAVESURVIVAL_API UWSLagCompensationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWSLagCompensationSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** The two recorded frames around a rewind time, resolved once per shot */
+	struct FRewindSample
+	{
+		int32 OlderFrame = INDEX_NONE;
+		int32 NewerFrame = INDEX_NONE;
+		float Alpha = 0.0f;
+
+		// Upper bound on how far any enemy has moved since the sample
+		float MaxDisplacement = 0.0f;
+	};
+
+	// Clamps a client-reported timestamp into the window the server will rewind to
+	double ClampRewindTimestamp(double Timestamp) const;
+
+	// False if nothing is recorded for Timestamp, in which case enemies should be tested where they are
+	bool FindRewindSample(double Timestamp, FRewindSample& OutSample) const;
+
+	// Location and yaw of one enemy at the sampled time. False if the enemy wasn't alive in either frame.
+	bool GetRewoundTransform(const FRewindSample& Sample, const FWSEnemyHandle& Handle, FVector& OutLocation, float& OutYaw) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Lag Compensation")
+	int32 GetHistoryMemoryBytes() const;
+
+	// Wall time of the most recent recording pass
+	UFUNCTION(BlueprintCallable, Category = "Lag Compensation")
+	float GetLastRecordMilliseconds() const;
+
+protected:
+	// Seconds between recorded frames; frames come no closer together than this, however fast the server ticks
+	UPROPERTY(Config, EditAnywhere, Category = "Lag Compensation")
+	float RecordInterval;
+
+	// Oldest client timestamp honoured, in seconds behind the server
+	UPROPERTY(Config, EditAnywhere, Category = "Lag Compensation")
+	float MaxRewindTime;
+
+	// Fastest any enemy moves; bounds how far a rewound enemy can be from its current grid cell
+	UPROPERTY(Config, EditAnywhere, Category = "Lag Compensation")
+	float MaxEnemySpeed;
+
+	/** One recorded frame, indexed by enemy handle slot */
+	struct FHistoryFrame
+	{
+		double Timestamp = -1.0;
+		TArray<float> X;
+		TArray<float> Y;
+		TArray<float> Z;
+		TArray<float> Yaw;
+
+		// Handle generation per slot, -1 where no enemy was alive
+		TArray<int32> Generations;
+	};
+
+	TArray<FHistoryFrame> Frames;
+	int32 NewestFrame;
+	double LastRecordTime;
+	bool bRecording;
+	float LastRecordMilliseconds;
+
+	void RecordFrame();
+};
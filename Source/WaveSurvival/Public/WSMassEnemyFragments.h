@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "WSTypes.h"
+#include "WSMassEnemyFragments.generated.h"
+
+/**
+ * Static configuration of a basic enemy simulated as a Mass entity, copied from its class defaults
+ */
+USTRUCT()
+struct WAVESURVIVAL_API FWSMassEnemyFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	EWSEnemyType EnemyType = EWSEnemyType::Aalix;
+	float MovementSpeed = 400.0f;
+	float AttackRange = 150.0f;
+};
+
+USTRUCT()
+struct WAVESURVIVAL_API FWSMassLocationFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector Location = FVector::ZeroVector;
+	FVector Facing = FVector::ForwardVector;
+};
+
+USTRUCT()
+struct WAVESURVIVAL_API FWSMassTargetFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector TargetLocation = FVector::ZeroVector;
+	float RetargetTimer = 0.0f;
+	bool bHasTarget = false;
+};
+
+/**
+ * Health carried between the actor and the entity on demotion and promotion. Entities take no
+ * damage themselves, so this only changes hands.
+ */
+USTRUCT()
+struct WAVESURVIVAL_API FWSMassHealthFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	float Health = 100.0f;
+
+	// Carried over to the actor on promotion so kill currency is split correctly
+	FWSDamageLedger DamageLedger;
+};
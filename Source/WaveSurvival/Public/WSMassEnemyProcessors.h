@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "WSMassEnemyProcessors.generated.h"
+
+/**
+ * Processors for basic enemies living as Mass entities. They are not auto-registered with the
+ * processing phases; UWSMassEnemySubsystem runs them in order every frame.
+ */
+
+/** Picks the nearest player as target and requests promotion to an actor when one is close */
+UCLASS()
+class WAVESURVIVAL_API UWSMassEnemyTargetingProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UWSMassEnemyTargetingProcessor();
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+/** Moves entities along the shared flow field toward their target */
+UCLASS()
+class WAVESURVIVAL_API UWSMassEnemyMovementProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UWSMassEnemyMovementProcessor();
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+/** Collects instance transforms for the entity visualization meshes */
+UCLASS()
+class WAVESURVIVAL_API UWSMassEnemyVisualizationProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UWSMassEnemyVisualizationProcessor();
+
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "WSTypes.h"
+#include "WSMassEnemyProxy.generated.h"
+
+/**
+ * Positions of the Mass entities one client draws, grouped by enemy type. Locations are quantized
+ * to LocationPrecision units and yaw to a byte, so each entity costs 7 bytes on the wire.
+ */
+USTRUCT()
+struct WAVESURVIVAL_API FWSMassEnemySnapshot
+{
+	GENERATED_BODY()
+
+	struct FTypeRange
+	{
+		EWSEnemyType EnemyType = EWSEnemyType::Aalix;
+		int32 Count = 0;
+
+		// Lets clients extrapolate between updates
+		float MovementSpeed = 0.0f;
+	};
+
+	// Consecutive runs of Locations and Yaws, one per enemy type
+	TArray<FTypeRange> Types;
+	TArray<FVector> Locations;
+	TArray<float> Yaws;
+
+	// Bumped by the server on every update so replication picks up the change
+	uint32 Sequence = 0;
+
+	static constexpr float LocationPrecision = 2.0f;
+
+	// 56 KB of entities, so a full snapshot stays within the engine's 64 KB partial bunch limit
+	static constexpr int32 MaxEntities = 8192;
+
+	void Reset();
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+	bool Identical(const FWSMassEnemySnapshot* Other, uint32 PortFlags) const { return Sequence == Other->Sequence; }
+};
+
+template<>
+struct TStructOpsTypeTraits<FWSMassEnemySnapshot> : public TStructOpsTypeTraitsBase2<FWSMassEnemySnapshot>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdentical = true,
+	};
+};
+
+/**
+ * Replicates Mass entity positions to one remote client, which has no entities of its own.
+ * Spawned by UWSMassEnemySubsystem on the server for each remote player and relevant only to
+ * that player; the client draws the snapshot with the same instanced meshes the host uses.
+ */
+UCLASS(NotPlaceable, Transient)
+class WAVESURVIVAL_API AWSMassEnemyProxy : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AWSMassEnemyProxy();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	const FWSMassEnemySnapshot& GetSnapshot() const { return Snapshot; }
+
+	// Server only; call MarkSnapshotDirty once filled
+	FWSMassEnemySnapshot& EditSnapshot() { return Snapshot; }
+	void MarkSnapshotDirty();
+
+protected:
+	UPROPERTY(ReplicatedUsing = OnRep_Snapshot)
+	FWSMassEnemySnapshot Snapshot;
+
+	UFUNCTION()
+	void OnRep_Snapshot();
+};
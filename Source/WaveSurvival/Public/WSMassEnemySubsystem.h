@@ -0,0 +1,179 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassEntityTypes.h"
+#include "MassArchetypeTypes.h"
+#include "WSTypes.h"
+#include "WSMassEnemyProxy.h"
+#include "WSMassEnemySubsystem.generated.h"
+
+class UMassProcessor;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+class AWSEnemyBase;
+
+/**
+ * Simulates basic enemies far from players as lightweight Mass entities. Entities are promoted to
+ * pooled AWSEnemyBase actors when a player gets close or aims at them, and actors of the same
+ * types are demoted back to entities once every player is far away.
+ *
+ * Entities take no damage: nothing targets them until they are promoted, which happens as soon
+ * as a player is close or aiming at them.
+ *
+ * Entities only exist on the server. The host draws them with instanced meshes, and each remote
+ * client draws the same meshes from a snapshot of the entities nearest its view, replicated
+ * through its own AWSMassEnemyProxy.
+ */
+UCLASS(Config = Game)
+class WAVESURVIVAL_API UWSMassEnemySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWSMassEnemySubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	UFUNCTION(BlueprintCallable, Category = "Enemy")
+	bool IsEntityEnemyType(EWSEnemyType EnemyType) const;
+
+	// True when a new enemy of this type at Location should start out as an entity
+	bool ShouldSimulateAsEntity(EWSEnemyType EnemyType, const FVector& Location) const;
+
+	// Creates an entity with the stats of the enemy type's class defaults
+	FMassEntityHandle SpawnEntity(EWSEnemyType EnemyType, const FVector& Location);
+
+	UFUNCTION(BlueprintCallable, Category = "Enemy")
+	int32 GetEntityCount() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Enemy")
+	int32 GetPromotedActorCount() const;
+
+	int32 GetMaxPromotedActors() const { return MaxPromotedActors; }
+
+	// Client: a new entity snapshot arrived from the server
+	void ReceiveSnapshot(AWSMassEnemyProxy* InProxy);
+
+	// Used by the enemy processors
+	struct FPlayerView
+	{
+		FVector Location;
+
+		// Camera of the owning client, as reported to the server
+		FVector ViewLocation;
+		FVector AimDirection;
+	};
+
+	const TArray<FPlayerView>& GetPlayerViews() const { return PlayerViews; }
+	float GetRetargetInterval() const { return RetargetInterval; }
+	bool ShouldPromote(const FVector& Location, float NearestDistSq, float& OutPriority) const;
+	void RequestPromotion(const FMassEntityHandle& Entity, float Priority);
+	TArray<FTransform>* GetVisualTransforms(EWSEnemyType EnemyType);
+
+protected:
+	// Enemy types simulated as entities while far from players
+	UPROPERTY(Config, EditAnywhere, Category = "Mass")
+	TArray<EWSEnemyType> EntityEnemyTypes;
+
+	// Entities closer than this to any player become actors
+	UPROPERTY(Config, EditAnywhere, Category = "Mass")
+	float PromotionDistance;
+
+	// Actors farther than this from every player become entities again
+	UPROPERTY(Config, EditAnywhere, Category = "Mass")
+	float DemotionDistance;
+
+	// Entities a player is aiming at within this range are promoted for hit detection
+	UPROPERTY(Config, EditAnywhere, Category = "Mass")
+	float AimPromotionDistance;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Mass")
+	float AimPromotionHalfAngle;
+
+	// Upper bound on live actors of entity-capable types
+	UPROPERTY(Config, EditAnywhere, Category = "Mass")
+	int32 MaxPromotedActors;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Mass")
+	int32 MaxPromotionsPerFrame;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Mass")
+	int32 MaxDemotionsPerFrame;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Mass")
+	float RetargetInterval;
+
+	// Seconds between entity snapshots sent to remote clients
+	UPROPERTY(Config, EditAnywhere, Category = "Mass")
+	float SnapshotInterval;
+
+	// Entities sent to each remote client per snapshot, nearest its view first. At 7 bytes each,
+	// 1024 entities every 0.1s is about 70 KB/s per client. Clamped to FWSMassEnemySnapshot::MaxEntities.
+	UPROPERTY(Config, EditAnywhere, Category = "Mass")
+	int32 MaxSnapshotEntities;
+
+	// Instanced mesh used to draw entities of each type
+	UPROPERTY(Config, EditAnywhere, Category = "Mass")
+	TMap<EWSEnemyType, TSoftObjectPtr<UStaticMesh>> EntityVisualMeshes;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UMassProcessor>> Processors;
+
+	UPROPERTY()
+	TObjectPtr<AActor> VisualActor;
+
+	// Server: one per remote player, owned by its controller
+	UPROPERTY()
+	TArray<TObjectPtr<AWSMassEnemyProxy>> ClientProxies;
+
+	// Client: this client's proxy, found through replication
+	UPROPERTY()
+	TObjectPtr<AWSMassEnemyProxy> Proxy;
+
+	struct FVisualBatch
+	{
+		UInstancedStaticMeshComponent* Instances = nullptr;
+		TArray<FTransform> Transforms;
+	};
+
+	TMap<EWSEnemyType, FVisualBatch> VisualBatches;
+
+	struct FPromotionRequest
+	{
+		FMassEntityHandle Entity;
+		float Priority;
+	};
+
+	FMassArchetypeHandle EnemyArchetype;
+	TArray<FPlayerView> PlayerViews;
+	TArray<FPromotionRequest> PromotionRequests;
+	int32 EntityCount;
+	bool bIsServer;
+	bool bPublishSnapshots;
+	float SnapshotAccumulator;
+	double SnapshotReceiveTime;
+
+	// Every entity in the current snapshot update, grouped by type, and the scratch used to pick each client's share
+	FWSMassEnemySnapshot AllEntities;
+	TArray<uint8> EntityTypeIndices;
+	TArray<TPair<float, int32>> EntityDistances;
+	TArray<int32> PickedEntities;
+
+	void GatherPlayerViews();
+	void PromoteRequestedEntities();
+	void DemoteDistantActors();
+	void UpdateClientProxies();
+	void PublishSnapshot(float DeltaTime);
+	void FillClientSnapshot(FWSMassEnemySnapshot& Snapshot, const FVector& ViewLocation);
+	void ExtrapolateSnapshot();
+	void UpdateVisuals();
+	float GetNearestPlayerDistSq(const FVector& Location) const;
+};
@@ -7,6 +7,9 @@
 #include "WSTypes.h"
 #include "WSPlayerState.generated.h"
 
+/** Fired when stats that weapons cache (PlayerStats, PlayerSlot) change */
+DECLARE_MULTICAST_DELEGATE(FWSOnCombatStatsChanged);
+
 /**
  * Player State tracks individual player data
  */
@@ -21,9 +24,13 @@ public:
 	virtual void BeginPlay() override;
 
 	// Player stats
-	UPROPERTY(BlueprintReadWrite, Replicated, Category = "Stats")
+	UPROPERTY(BlueprintReadWrite, ReplicatedUsing = OnRep_PlayerStats, Category = "Stats")
 	FWSPlayerStats PlayerStats;
 
+	// Slot index assigned by the game mode on login, INDEX_NONE until then
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_PlayerSlot, Category = "Player")
+	int32 PlayerSlot;
+
 	// Character class
 	UPROPERTY(BlueprintReadWrite, Replicated, Category = "Character")
 	EWSCharacterClass CharacterClass;
@@ -57,6 +64,8 @@ public:
 	UPROPERTY(BlueprintReadWrite, Replicated, Category = "Stats")
 	float DamageDealt;
 
+	FWSOnCombatStatsChanged OnCombatStatsChanged;
+
 	// Functions
 	UFUNCTION(BlueprintCallable, Category = "Economy")
 	void AddCurrency(int32 Amount);
@@ -82,8 +91,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Stats")
 	void OnRevive();
 
+	// Player slot of the player controlling DamageCauser, INDEX_NONE if none
+	static int32 GetPlayerSlotForActor(const AActor* DamageCauser);
+
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 protected:
 	void ApplyUpgradeEffects(const FWSUpgradeCardData& UpgradeCard);
+
+	// Clients' weapons cache these too, so they need the same notification the server sends
+	UFUNCTION()
+	void OnRep_PlayerStats();
+
+	UFUNCTION()
+	void OnRep_PlayerSlot();
 };
@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WSProjectileSubsystem.generated.h"
+
+class AWSWeaponBase;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/**
+ * Simulates every live projectile in packed arrays instead of one actor per projectile.
+ * Projectiles are swept against world geometry once per frame and against enemies from the
+ * spatial grid in sub-steps, and drawn as instances from the same buffers.
+ */
+UCLASS(Config = Game)
+class WAVESURVIVAL_API UWSProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWSProjectileSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Weapon may be null for projectiles that deal no damage (e.g. a predicting client's own shots, or the stress test)
+	void SpawnProjectile(AWSWeaponBase* Weapon, const FVector& Location, const FVector& Velocity, float MaxDistance, float Radius);
+
+	UFUNCTION(BlueprintCallable, Category = "Projectile")
+	int32 GetProjectileCount() const;
+
+	// Spawns Count harmless projectiles around the first player and logs the average update cost
+	void RunStressTest(int32 Count, int32 Frames);
+
+	// Whether a projectile of Radius moving from Start to End touches an upright capsule. OutDistSq is the
+	// squared distance from Start to the closest point of the path.
+	static bool SweepCapsule(const FVector& Start, const FVector& End, float Radius, const FVector& CapsuleCenter,
+		float CapsuleRadius, float CapsuleHalfHeight, float& OutDistSq);
+
+protected:
+	// Longest distance a projectile moves between enemy hit tests
+	UPROPERTY(Config, EditAnywhere, Category = "Projectile")
+	float MaxSubstepDistance;
+
+	// Added to grid query radii so large enemy capsules are not missed
+	UPROPERTY(Config, EditAnywhere, Category = "Projectile")
+	float EnemyQueryPadding;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Projectile")
+	TSoftObjectPtr<UStaticMesh> ProjectileMesh;
+
+	UPROPERTY()
+	TObjectPtr<AActor> VisualActor;
+
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> VisualInstances;
+
+	// Live projectiles, parallel arrays
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<float> RemainingDistances;
+	TArray<float> Radii;
+	TArray<TWeakObjectPtr<AWSWeaponBase>> Weapons;
+
+	// Scratch buffers
+	TArray<AActor*> Candidates;
+	TArray<FTransform> VisualTransforms;
+
+	// Stress test timing
+	int32 StressFramesRemaining;
+	int32 StressFramesTotal;
+	double StressAccumulatedMs;
+
+	void RemoveProjectile(int32 Index);
+	bool SweepEnemies(int32 Index, const FVector& Start, const FVector& End);
+	void UpdateVisuals();
+};
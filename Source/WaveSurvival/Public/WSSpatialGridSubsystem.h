@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WSTypes.h"
+#include "WSSpatialGridSubsystem.generated.h"
+
+/**
+ * Uniform 2D spatial hash of registered players and enemies.
+ * Entries are refreshed once per frame and only re-bucketed when they change cell.
+ */
+UCLASS()
+class WAVESURVIVAL_API UWSSpatialGridSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWSSpatialGridSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Registration
+	UFUNCTION(BlueprintCallable, Category = "Spatial")
+	void RegisterActor(AActor* Actor, EWSSpatialCategory Category);
+
+	UFUNCTION(BlueprintCallable, Category = "Spatial")
+	void UnregisterActor(AActor* Actor);
+
+	// Queries
+	UFUNCTION(BlueprintCallable, Category = "Spatial")
+	AActor* FindNearest(FVector Location, EWSSpatialCategory Category, float MaxRadius = 0.0f) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Spatial")
+	int32 FindNearestN(FVector Location, EWSSpatialCategory Category, int32 Count, TArray<AActor*>& OutActors, float MaxRadius = 0.0f) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Spatial")
+	int32 QueryRadius(FVector Location, float Radius, EWSSpatialCategory Category, TArray<AActor*>& OutActors) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Spatial")
+	int32 QueryCone(FVector Origin, FVector Direction, float Range, float HalfAngleDegrees, EWSSpatialCategory Category, TArray<AActor*>& OutActors) const;
+
+	// Entries within Radius of the segment from Start to End
+	UFUNCTION(BlueprintCallable, Category = "Spatial")
+	int32 QuerySegment(FVector Start, FVector End, float Radius, EWSSpatialCategory Category, TArray<AActor*>& OutActors) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Spatial")
+	int32 CountInRadius(FVector Location, float Radius, EWSSpatialCategory Category) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Spatial")
+	int32 GetRegisteredCount(EWSSpatialCategory Category) const;
+
+	// Starts at FirstActor and hops up to MaxHops times, each time to the nearest entry within JumpRadius of the
+	// previous link that isn't already in the chain. OutChain begins with FirstActor.
+	int32 QueryChain(AActor* FirstActor, EWSSpatialCategory Category, int32 MaxHops, float JumpRadius, TArray<AActor*>& OutChain) const;
+
+	// Logs the average cost of QueryChain against a linear scan of every entry
+	void RunChainBenchmark(int32 NumChains, int32 MaxHops, float JumpRadius) const;
+
+	// Packs the XY positions of entries in cells near Location into parallel arrays for vectorized kernels
+	int32 GatherPackedPositions(const FVector& Location, float Radius, EWSSpatialCategory Category, TArray<float>& OutX, TArray<float>& OutY) const;
+
+protected:
+	// Edge length of a grid cell in world units
+	UPROPERTY(EditAnywhere, Category = "Spatial")
+	float CellSize;
+
+	struct FEntry
+	{
+		AActor* Actor;
+		FVector Location;
+		FIntPoint Cell;
+	};
+
+	struct FLayer
+	{
+		TArray<FEntry> Entries;
+		TMap<AActor*, int32> EntryIndices;
+		TMap<FIntPoint, TArray<int32>> Cells;
+		FIntPoint MinCell = FIntPoint::ZeroValue;
+		FIntPoint MaxCell = FIntPoint::ZeroValue;
+	};
+
+	FLayer Layers[2];
+
+	FLayer& GetLayer(EWSSpatialCategory Category) { return Layers[(uint8)Category]; }
+	const FLayer& GetLayer(EWSSpatialCategory Category) const { return Layers[(uint8)Category]; }
+
+	FIntPoint GetCell(const FVector& Location) const;
+	void AddToCell(FLayer& Layer, const FIntPoint& Cell, int32 EntryIndex);
+	void RemoveFromCell(FLayer& Layer, const FIntPoint& Cell, int32 EntryIndex);
+	void RefreshLayer(FLayer& Layer);
+
+	// Calls Visitor(EntryIndex) for every entry in cells overlapping the square around Location
+	template <typename VisitorType>
+	void ForEachEntryInSquare(const FLayer& Layer, const FVector& Location, float HalfExtent, VisitorType&& Visitor) const;
+};
@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WSTypes.h"
+#include "WSStatusEffectSubsystem.generated.h"
+
+/**
+ * Ticks every active elemental status effect on a fixed step instead of per-enemy timers.
+ * Effects are stored per element as parallel arrays keyed by enemy handle. Burn and poison
+ * damage is fed through UWSDamageSubsystem; slow and armor shred are pushed onto the enemy
+ * when their stacks change.
+ */
+UCLASS(Config = Game)
+class WAVESURVIVAL_API UWSStatusEffectSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWSStatusEffectSubsystem();
+
+	static constexpr int32 NumElements = (int32)EWSElementalType::Poison + 1;
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Adds a stack (or refreshes the duration) of Element on Target. Returns false if Element isn't a tracked status effect.
+	bool ApplyEffect(const FWSEnemyHandle& Target, EWSElementalType Element, int32 InstigatorSlot);
+
+	UFUNCTION(BlueprintCallable, Category = "Status Effects")
+	int32 GetActiveEffectCount(EWSElementalType Element) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Status Effects")
+	int32 GetTotalActiveEffectCount() const;
+
+	// Wall time of the most recent step
+	UFUNCTION(BlueprintCallable, Category = "Status Effects")
+	float GetLastStepMilliseconds() const;
+
+protected:
+	// Seconds between status effect steps
+	UPROPERTY(Config, EditAnywhere, Category = "Status Effects")
+	float StepInterval;
+
+	// Steps run in one frame after a hitch; time beyond this is dropped
+	UPROPERTY(Config, EditAnywhere, Category = "Status Effects")
+	int32 MaxStepsPerFrame;
+
+	// Duration and stacking per element, indexed by EWSElementalType
+	UPROPERTY(Config, EditAnywhere, Category = "Status Effects")
+	TArray<FWSStatusEffectSettings> EffectSettings;
+
+	/** Active effects of one element, stored as parallel arrays */
+	struct FEffectBatch
+	{
+		TArray<FWSEnemyHandle> Targets;
+		TArray<float> RemainingTimes;
+		TArray<int32> Stacks;
+
+		// MagnitudePerStack * Stacks, kept up to date on every application
+		TArray<float> Intensities;
+		TArray<int32> InstigatorSlots;
+
+		TMap<FWSEnemyHandle, int32> Indices;
+
+		int32 Num() const { return Targets.Num(); }
+	};
+
+	FEffectBatch Batches[NumElements];
+
+	float StepAccumulator;
+	float LastStepMilliseconds;
+
+	// Scratch buffer for per-step damage
+	TArray<float> StepDamages;
+
+	void Step(float StepTime);
+	void RemoveEffect(FEffectBatch& Batch, int32 Index);
+
+	// Pushes a slow or armor shred intensity onto the enemy; no-op for damage-over-time elements
+	void ApplyModifier(const FWSEnemyHandle& Target, EWSElementalType Element, float Intensity) const;
+
+	static bool IsDamageOverTime(EWSElementalType Element);
+};
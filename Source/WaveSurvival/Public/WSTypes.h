@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "WSTypes.generated.h"
 
+// Maximum players in a match; player slots are indices below this
+constexpr int32 WSMaxPlayers = 4;
+
 /**
  * Game mode types
  */
@@ -169,7 +172,353 @@ enum class EWSWeaponFireMode : uint8
 {
 	Hitscan UMETA(DisplayName = "Hitscan"),
 	Projectile UMETA(DisplayName = "Projectile"),
-	Melee UMETA(DisplayName = "Melee")
+	Melee UMETA(DisplayName = "Melee"),
+	PelletSpread UMETA(DisplayName = "Pellet Spread"),
+	Piercing UMETA(DisplayName = "Piercing")
+};
+
+/**
+ * Body regions of an enemy hitbox
+ */
+UENUM(BlueprintType)
+enum class EWSHitRegion : uint8
+{
+	Body UMETA(DisplayName = "Body"),
+	Head UMETA(DisplayName = "Head"),
+	Limb UMETA(DisplayName = "Limb")
+};
+
+/**
+ * One analytic hitbox: a capsule with a vertical axis, or a sphere when HalfHeight is zero
+ */
+USTRUCT(BlueprintType)
+struct FWSHitbox
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EWSHitRegion Region;
+
+	// Centre relative to the actor, rotated with it
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector Offset;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Radius;
+
+	// Half length of the axis segment, not counting the end caps
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float HalfHeight;
+
+	FWSHitbox()
+		: Region(EWSHitRegion::Body)
+		, Offset(FVector::ZeroVector)
+		, Radius(30.0f)
+		, HalfHeight(0.0f)
+	{
+	}
+
+	FWSHitbox(EWSHitRegion InRegion, const FVector& InOffset, float InRadius, float InHalfHeight)
+		: Region(InRegion)
+		, Offset(InOffset)
+		, Radius(InRadius)
+		, HalfHeight(InHalfHeight)
+	{
+	}
+};
+
+/**
+ * Categories tracked by the spatial grid
+ */
+UENUM(BlueprintType)
+enum class EWSSpatialCategory : uint8
+{
+	Player UMETA(DisplayName = "Player"),
+	Enemy UMETA(DisplayName = "Enemy")
+};
+
+/**
+ * Enemy significance buckets, nearest first
+ */
+UENUM(BlueprintType)
+enum class EWSEnemyLOD : uint8
+{
+	Near UMETA(DisplayName = "Near"),
+	Mid UMETA(DisplayName = "Mid"),
+	Far UMETA(DisplayName = "Far"),
+	Dormant UMETA(DisplayName = "Dormant")
+};
+
+/**
+ * Update rates for one enemy significance bucket
+ */
+USTRUCT(BlueprintType)
+struct FWSEnemyLODSettings
+{
+	GENERATED_BODY()
+
+	// Enemies up to this distance from the nearest player use this bucket (0 = unbounded)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float MaxDistance;
+
+	// Seconds between batch updates (0 = every frame)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float UpdateInterval;
+
+	// Seconds between target re-evaluations
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float RetargetInterval;
+
+	// Tick interval for movement and mesh components (0 = every frame)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float MovementTickInterval;
+
+	FWSEnemyLODSettings()
+		: MaxDistance(0.0f)
+		, UpdateInterval(0.0f)
+		, RetargetInterval(0.2f)
+		, MovementTickInterval(0.0f)
+	{
+	}
+
+	FWSEnemyLODSettings(float InMaxDistance, float InUpdateInterval, float InRetargetInterval, float InMovementTickInterval)
+		: MaxDistance(InMaxDistance)
+		, UpdateInterval(InUpdateInterval)
+		, RetargetInterval(InRetargetInterval)
+		, MovementTickInterval(InMovementTickInterval)
+	{
+	}
+};
+
+/**
+ * Duration and stacking rules for one elemental status effect
+ */
+USTRUCT(BlueprintType)
+struct FWSStatusEffectSettings
+{
+	GENERATED_BODY()
+
+	// Seconds the effect lasts after its latest application (0 = not tracked as a status effect)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Duration;
+
+	// Damage per second, slow fraction or armor reduction added by each stack
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float MagnitudePerStack;
+
+	// Same rules as upgrade cards: non-stackable effects only refresh their duration
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bStackable;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 MaxStacks;
+
+	FWSStatusEffectSettings()
+		: Duration(0.0f)
+		, MagnitudePerStack(0.0f)
+		, bStackable(true)
+		, MaxStacks(1)
+	{
+	}
+
+	FWSStatusEffectSettings(float InDuration, float InMagnitudePerStack, bool bInStackable, int32 InMaxStacks)
+		: Duration(InDuration)
+		, MagnitudePerStack(InMagnitudePerStack)
+		, bStackable(bInStackable)
+		, MaxStacks(InMaxStacks)
+	{
+	}
+};
+
+/**
+ * What a persistent zone does to the actors inside it
+ */
+UENUM(BlueprintType)
+enum class EWSZoneEffect : uint8
+{
+	Slow UMETA(DisplayName = "Slow Field"),
+	Shield UMETA(DisplayName = "Shield"),
+	Acid UMETA(DisplayName = "Acid Pool")
+};
+
+UENUM(BlueprintType)
+enum class EWSZoneShape : uint8
+{
+	Sphere UMETA(DisplayName = "Sphere"),
+	Box UMETA(DisplayName = "Box")
+};
+
+/**
+ * Shape, lifetime and strength of one persistent zone. Shield zones affect players; the others affect enemies.
+ */
+USTRUCT(BlueprintType)
+struct FWSZoneSpec
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EWSZoneEffect Effect;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EWSZoneShape Shape;
+
+	// Sphere radius
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Radius;
+
+	// Box half size, rotated with the zone transform
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector HalfExtent;
+
+	// Seconds before the zone expires (0 = until removed)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Duration;
+
+	// Slow fraction, armor reduction or damage reduction applied while inside
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Magnitude;
+
+	// Damage per second dealt to enemies inside
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float DamagePerSecond;
+
+	FWSZoneSpec()
+		: Effect(EWSZoneEffect::Slow)
+		, Shape(EWSZoneShape::Sphere)
+		, Radius(500.0f)
+		, HalfExtent(500.0f, 500.0f, 200.0f)
+		, Duration(5.0f)
+		, Magnitude(0.0f)
+		, DamagePerSecond(0.0f)
+	{
+	}
+};
+
+/**
+ * Server's view of a predicted weapon, sent to the owning client to confirm or correct its prediction
+ */
+USTRUCT()
+struct FWSWeaponAck
+{
+	GENERATED_BODY()
+
+	// Last client shot sequence the server has processed
+	UPROPERTY()
+	uint16 ShotSequence;
+
+	// 16 bits so large magazines aren't clamped
+	UPROPERTY()
+	uint16 Ammo;
+
+	// Reloads started so far, wrapping; tells the client which reload the ack was taken after
+	UPROPERTY()
+	uint8 ReloadCount;
+
+	UPROPERTY()
+	bool bIsReloading;
+
+	FWSWeaponAck()
+		: ShotSequence(0)
+		, Ammo(0)
+		, ReloadCount(0)
+		, bIsReloading(false)
+	{
+	}
+};
+
+/**
+ * Stable reference to an enemy registered with the enemy manager
+ */
+USTRUCT(BlueprintType)
+struct FWSEnemyHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Index;
+
+	UPROPERTY()
+	int32 Generation;
+
+	FWSEnemyHandle()
+		: Index(INDEX_NONE)
+		, Generation(0)
+	{
+	}
+
+	FWSEnemyHandle(int32 InIndex, int32 InGeneration)
+		: Index(InIndex)
+		, Generation(InGeneration)
+	{
+	}
+
+	bool IsSet() const
+	{
+		return Index != INDEX_NONE;
+	}
+
+	bool operator==(const FWSEnemyHandle& Other) const
+	{
+		return Index == Other.Index && Generation == Other.Generation;
+	}
+
+	bool operator!=(const FWSEnemyHandle& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FWSEnemyHandle& Handle)
+	{
+		return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation));
+	}
+};
+
+/**
+ * Damage dealt to one enemy by each player slot, with the top dealer tracked as damage arrives
+ */
+struct FWSDamageLedger
+{
+	float DamageBySlot[WSMaxPlayers];
+	int32 TopSlot;
+
+	FWSDamageLedger()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		for (int32 Slot = 0; Slot < WSMaxPlayers; ++Slot)
+		{
+			DamageBySlot[Slot] = 0.0f;
+		}
+		TopSlot = INDEX_NONE;
+	}
+
+	void AddDamage(int32 Slot, float Amount)
+	{
+		if (Slot < 0 || Slot >= WSMaxPlayers || Amount <= 0.0f)
+		{
+			return;
+		}
+
+		// Totals only grow, so the running maximum stays exact
+		DamageBySlot[Slot] += Amount;
+		if (TopSlot == INDEX_NONE || DamageBySlot[Slot] > DamageBySlot[TopSlot])
+		{
+			TopSlot = Slot;
+		}
+	}
+
+	float GetDamage(int32 Slot) const
+	{
+		return (Slot >= 0 && Slot < WSMaxPlayers) ? DamageBySlot[Slot] : 0.0f;
+	}
+
+	int32 GetTopSlot() const
+	{
+		return TopSlot;
+	}
 };
 
 /**
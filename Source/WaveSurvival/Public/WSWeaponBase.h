@@ -7,6 +7,25 @@
 #include "WSTypes.h"
 #include "WSWeaponBase.generated.h"
 
+class AWSEnemyBase;
+class AWSPlayerState;
+
+/**
+ * Owner stats a weapon reads on every shot, resolved once and rebuilt when they change
+ */
+struct FWSWeaponStatSnapshot
+{
+	float DamageMultiplier = 1.0f;
+	float CriticalChance = 0.0f;
+	float CriticalDamageMultiplier = 1.0f;
+	float ReloadSpeed = 1.0f;
+
+	// Zero unless the weapon has an element
+	float ElementalDamagePercent = 0.0f;
+
+	int32 PlayerSlot = INDEX_NONE;
+};
+
 /**
  * Base class for all weapons
  */
@@ -19,7 +38,9 @@ public:
 	AWSWeaponBase();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
+	virtual void SetOwner(AActor* NewOwner) override;
 
 	// Weapon configuration
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon")
@@ -46,6 +67,90 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon")
 	bool bAutomatic;
 
+	// Trace hitscan shots immediately instead of through the batched async queue
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon")
+	bool bPreciseHitscan;
+
+	// Pellet spread; BaseDamage is split evenly across the pellets of a shot
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Pellets")
+	int32 PelletCount;
+
+	// Half angle of the spread cone in degrees
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Pellets")
+	float PelletSpreadAngle;
+
+	// Pellets deal full damage up to this distance
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Pellets")
+	float FalloffStartRange;
+
+	// Distance at which pellet damage bottoms out at MinFalloffMultiplier
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Pellets")
+	float FalloffEndRange;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Pellets")
+	float MinFalloffMultiplier;
+
+	// Projectiles
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Projectile")
+	float ProjectileSpeed;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Projectile")
+	float ProjectileRadius;
+
+	// Melee; the swing reaches Range in front of the owner
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Melee")
+	float MeleeHalfAngle;
+
+	// Closest enemies hit by one swing
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Melee")
+	int32 MaxMeleeTargets;
+
+	// Chain damage; used by the Lightning Gun and electric weapons
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Chain")
+	int32 MaxChainHops;
+
+	// Farthest a chain can jump from one enemy to the next
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Chain")
+	float ChainJumpRadius;
+
+	// Damage multiplier applied per hop
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Chain")
+	float ChainDamageFalloff;
+
+	// Piercing shots pass through enemies until the summed PenetrationResistance of those hit reaches this
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Piercing")
+	float PenetrationBudget;
+
+	// Damage multiplier applied per enemy already pierced
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Piercing")
+	float PierceDamageFalloff;
+
+	// Damage multipliers by hitbox region on hitscan and pellet hits
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Hitboxes")
+	float HeadshotMultiplier;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Hitboxes")
+	float LimbMultiplier;
+
+	// Every hit counts as a headshot (Rogue ultimate)
+	UPROPERTY(BlueprintReadWrite, Category = "Weapon|Hitboxes")
+	bool bAllShotsHeadshots;
+
+	// Seconds between ammo acks to a remote owner while it fires; corrections are sent immediately
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Network")
+	float AckInterval;
+
+	// A remote owner's shot that arrives this close to the end of the server's reload finishes it early,
+	// since the owner started (and finished) its predicted reload half a round trip sooner. Only shots the
+	// owner fired after starting that same reload qualify.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Network")
+	float ReloadGraceTime;
+
+	// Seconds of fire a remote owner may bank while not shooting, so batches bunched up by network jitter
+	// aren't rejected. Beyond it the server accepts at most one shot per FireRate, plus one.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Weapon|Network")
+	float FireRateTolerance;
+
 	// Ammo
 	UPROPERTY(BlueprintReadOnly, Category = "Weapon")
 	int32 CurrentAmmo;
@@ -67,6 +172,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Weapon")
 	void Fire();
 
+	// Server only: fires one shot as a remote client saw it, testing enemies where they were at ClientTimestamp
+	// (server world time, negative for the present) along AimDirection (zero to use the owner's view)
+	void FireAtTime(double ClientTimestamp, const FVector& AimDirection);
+
+	// Muzzle flash, sound and recoil; plays as soon as the trigger is pulled, including on predicting clients
+	UFUNCTION(BlueprintImplementableEvent, Category = "Weapon")
+	void OnFireEffects();
+
+	// Server world time the shot being fired is tested at; negative for the present
+	double GetShotTimestamp() const { return ShotTimestamp; }
+
 	UFUNCTION(BlueprintCallable, Category = "Weapon")
 	void Reload();
 
@@ -76,6 +192,39 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Weapon")
 	bool NeedsReload() const;
 
+	// Forces the owner stat snapshot to be rebuilt; call after changing ElementalType or ElementalDamagePercent
+	UFUNCTION(BlueprintCallable, Category = "Weapon")
+	void InvalidateStatSnapshot();
+
+	// Rebuilt lazily when invalid; otherwise no casts or lookups
+	const FWSWeaponStatSnapshot& GetStatSnapshot();
+
+	// Applies the outcome of a hitscan trace, whether it was traced immediately or by UWSHitscanSubsystem
+	void ApplyHitscanResult(bool bHit, const FHitResult& HitResult, const FVector& TraceStart, const FVector& TraceEnd);
+
+	FCollisionQueryParams GetHitscanQueryParams() const;
+
+	// Drains whole fire intervals from Accumulator after adding DeltaTime, up to MaxShots. Returns the shots owed.
+	static int32 ConsumeShotsOwed(float& Accumulator, float DeltaTime, float FireInterval, int32 MaxShots);
+
+	// Server side of the fire rate: whether one more shot fits at time Now, advancing ShotClock (the time of the
+	// last accepted shot) by FireInterval if so. ShotClock never lags Now by more than Tolerance.
+	static bool ConsumeFireRateBudget(double& ShotClock, double Now, float FireInterval, float Tolerance);
+
+	// Client side of an ack: the acked ammo less the shots fired since AckedSequence, which are still in flight
+	static int32 GetCorrectedAmmo(uint16 AckedAmmo, uint16 AckedSequence, uint16 NextSequence);
+
+	// Reloads the ack is ahead of the client by, across wrap; negative if sent before a reload the client already started
+	static int8 GetReloadDelta(uint8 AckReloadCount, uint8 LocalReloadCount);
+
+	// Applies every pellet of one trigger pull, with one damage application per enemy hit
+	void ApplyPelletResults(const TArray<FHitResult>& PelletHits, const FVector& TraceStart);
+
+	// Rolls damage scaled by DamageScale and queues it, with this weapon's element, on UWSDamageSubsystem.
+	// Chaining weapons also damage up to MaxChainHops enemies beyond the one hit, unless bCanChain is false;
+	// shots that hit several enemies pass it for the first only, so each shot starts at most one chain.
+	void DamageEnemy(AWSEnemyBase* Enemy, float DamageScale, bool bCanChain = true);
+
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	USkeletalMeshComponent* WeaponMesh;
@@ -83,13 +232,77 @@ protected:
 	bool bIsFiring;
 	bool bIsReloading;
 	float TimeSinceLastShot;
+
+	// Time banked toward the next automatic shot; carries the remainder across frames
+	float ShotAccumulator;
+
+	// Set for the duration of FireAtTime
+	double ShotTimestamp;
+	FVector ShotAimDirection;
+
+	// Reloads started, wrapping; matched between client and server to order acks against reloads
+	uint8 ReloadCount;
+
+	// Owning client prediction: shots fired this frame are sent as one batch
+	uint16 NextShotSequence;
+	uint16 PendingFirstSequence;
+	uint8 PendingShotCount;
+
+	// Server: last shot sequence processed for the remote owner and whether it still needs an ack
+	uint16 LastServerSequence;
+
+	// Server: fire-rate clock for the remote owner's shots, see ConsumeFireRateBudget
+	double LastAcceptedShotTime;
+	bool bAckPending;
+	float TimeSinceAck;
 	FTimerHandle ReloadTimerHandle;
 
+	FWSWeaponStatSnapshot StatSnapshot;
+	bool bStatSnapshotValid;
+
+	// Player state the snapshot listens to for stat changes
+	TWeakObjectPtr<AWSPlayerState> SnapshotPlayerState;
+	FDelegateHandle StatsChangedHandle;
+
+	// Scratch buffers for melee, chain and piercing queries
+	TArray<AActor*> MeleeCandidates;
+	TArray<AActor*> ChainLinks;
+	TArray<FHitResult> PierceHits;
+
 	virtual void PerformHitscan();
+	bool GetHitscanRay(FVector& OutStart, FVector& OutEnd) const;
+
+	// Immediate trace against world geometry and enemy hitboxes
+	bool TraceShot(const FVector& TraceStart, const FVector& TraceEnd, FHitResult& OutHit) const;
+	virtual void PerformPelletSpread();
+	virtual void PerformPiercing();
 	virtual void PerformProjectile();
 	virtual void PerformMelee();
+
+	bool ChainsDamage() const;
+	void DamageChain(AWSEnemyBase* FirstEnemy, float DamageScale);
+	void DamageSingleEnemy(AWSEnemyBase* Enemy, float DamageScale);
 	
+	void RefreshStatSnapshot();
+	void UnbindStatSnapshot();
+
+	// True on a client, where shots and reloads are predicted and sent to the server
+	bool IsPredictingClient() const;
+	void FlushPredictedShots();
+	void StartReload();
+	void SendAck();
+
+	UFUNCTION(Server, Reliable)
+	void ServerFireShots(uint16 FirstSequence, uint8 ShotCount, uint8 ClientReloadCount, double ClientTimestamp, FVector_NetQuantizeNormal AimDirection);
+
+	UFUNCTION(Server, Reliable)
+	void ServerReload();
+
+	UFUNCTION(Client, Reliable)
+	void ClientAckShots(FWSWeaponAck Ack);
+
 	void FinishReload();
 	float CalculateDamage(bool& bOutIsCritical);
-	void ApplyElementalEffect(AActor* Target);
+	float GetFalloffMultiplier(float Distance) const;
+	float GetRegionMultiplier(const FHitResult& HitResult) const;
 };
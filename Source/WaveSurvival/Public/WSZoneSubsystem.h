@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WSTypes.h"
+#include "WSZoneSubsystem.generated.h"
+
+/**
+ * Persistent area effects (slow fields, shields, acid pools) without collision volumes.
+ * On a fixed step each zone queries the spatial grid for the actors inside it and diffs the
+ * result against last step's members, applying modifiers to arrivals and removing them from
+ * departures. Cost follows zones times local density rather than overlap events.
+ */
+UCLASS(Config = Game)
+class WAVESURVIVAL_API UWSZoneSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWSZoneSubsystem();
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Returns an id for SetZoneTransform and RemoveZone. Membership is picked up on the next step.
+	UFUNCTION(BlueprintCallable, Category = "Zones")
+	int32 AddZone(const FWSZoneSpec& Spec, const FTransform& Transform, int32 InstigatorSlot);
+
+	// Moves a zone, e.g. a shield following its caster
+	UFUNCTION(BlueprintCallable, Category = "Zones")
+	bool SetZoneTransform(int32 ZoneId, const FTransform& Transform);
+
+	// Ends a zone early and removes its modifiers from everything inside
+	UFUNCTION(BlueprintCallable, Category = "Zones")
+	bool RemoveZone(int32 ZoneId);
+
+	UFUNCTION(BlueprintCallable, Category = "Zones")
+	int32 GetZoneCount() const;
+
+	// Actors inside any zone as of the last step
+	UFUNCTION(BlueprintCallable, Category = "Zones")
+	int32 GetTotalMemberCount() const;
+
+protected:
+	// Seconds between membership updates
+	UPROPERTY(Config, EditAnywhere, Category = "Zones")
+	float StepInterval;
+
+	// Steps run in one frame after a hitch; time beyond this is dropped
+	UPROPERTY(Config, EditAnywhere, Category = "Zones")
+	int32 MaxStepsPerFrame;
+
+	/** One actor inside a zone, ordered by Key for diffing */
+	struct FZoneMember
+	{
+		// Enemy handle for enemies, so a pooled enemy reused elsewhere counts as a new member
+		uint64 Key = 0;
+		FWSEnemyHandle Handle;
+		TWeakObjectPtr<AActor> Actor;
+
+		bool operator<(const FZoneMember& Other) const { return Key < Other.Key; }
+	};
+
+	struct FZone
+	{
+		int32 Id = INDEX_NONE;
+		FWSZoneSpec Spec;
+		FTransform Transform;
+		float RemainingTime = 0.0f;
+		int32 InstigatorSlot = INDEX_NONE;
+
+		// Sorted by Key
+		TArray<FZoneMember> Members;
+	};
+
+	TArray<FZone> Zones;
+	int32 NextZoneId;
+	float StepAccumulator;
+
+	// Scratch buffers for the membership query
+	TArray<AActor*> Candidates;
+	TArray<FZoneMember> NewMembers;
+
+	void Step(float StepTime);
+	void RemoveZoneAt(int32 ZoneIndex);
+	void GatherMembers(const FZone& Zone, TArray<FZoneMember>& OutMembers);
+
+	// Adds (Sign = 1) or removes (Sign = -1) the zone's modifier on one member; skips members that died or were pooled
+	void ApplyModifier(const FZone& Zone, const FZoneMember& Member, float Sign) const;
+
+	static bool AffectsPlayers(const FWSZoneSpec& Spec);
+};
@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("WaveSurvival"), STATGROUP_WaveSurvival, STATCAT_Advanced);
 
 class FWaveSurvivalModule : public IModuleInterface
 {
@@ -24,7 +24,9 @@ public class WaveSurvival : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new string[] 
 		{
-			"EOSShared"
+			"EOSShared",
+			"NavigationSystem",
+			"MassEntity"
 		});
 
 		// To include OnlineSubsystemSteam, add it to the plugins section in your uproject file with the Enabled attribute set to true